@@ -0,0 +1,92 @@
+#include "ArenaBounds.h"
+#include <math.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ARENA_BOUNDS_SSE
+#endif
+
+ArenaBounds::ArenaBounds() :
+	half_width_(0.0f),
+	half_height_(0.0f)
+{
+}
+
+void ArenaBounds::Init(float half_width, float half_height)
+{
+	half_width_ = half_width;
+	half_height_ = half_height;
+}
+
+bool ArenaBounds::ClampBody(b2Body* body, float margin) const
+{
+	const float limit_x = half_width_ - margin;
+	const float limit_y = half_height_ - margin;
+
+	b2Vec2 position = body->GetPosition();
+	b2Vec2 velocity = body->GetLinearVelocity();
+	bool clamped = false;
+
+	if (fabsf(position.x) > limit_x)
+	{
+		position.x = position.x > 0.0f ? limit_x : -limit_x;
+		if (velocity.x * position.x > 0.0f)
+			velocity.x = 0.0f;
+		clamped = true;
+	}
+
+	if (fabsf(position.y) > limit_y)
+	{
+		position.y = position.y > 0.0f ? limit_y : -limit_y;
+		if (velocity.y * position.y > 0.0f)
+			velocity.y = 0.0f;
+		clamped = true;
+	}
+
+	if (clamped)
+	{
+		body->SetTransform(position, body->GetAngle());
+		body->SetLinearVelocity(velocity);
+	}
+
+	return clamped;
+}
+
+int ArenaBounds::TestOutside(const float* xs, const float* ys, int count, UInt8* outside, float margin) const
+{
+	const float half_width = half_width_ - margin;
+	const float half_height = half_height_ - margin;
+
+	int num_outside = 0;
+	int i = 0;
+
+#ifdef ARENA_BOUNDS_SSE
+	// |x| > half_width || |y| > half_height, with the sign bit masked off for the abs
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128 limit_x = _mm_set1_ps(half_width);
+	const __m128 limit_y = _mm_set1_ps(half_height);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_and_ps(_mm_loadu_ps(xs + i), abs_mask);
+		__m128 y = _mm_and_ps(_mm_loadu_ps(ys + i), abs_mask);
+		__m128 out = _mm_or_ps(_mm_cmpgt_ps(x, limit_x), _mm_cmpgt_ps(y, limit_y));
+
+		int bits = _mm_movemask_ps(out);
+		outside[i + 0] = (UInt8)(bits & 1);
+		outside[i + 1] = (UInt8)((bits >> 1) & 1);
+		outside[i + 2] = (UInt8)((bits >> 2) & 1);
+		outside[i + 3] = (UInt8)((bits >> 3) & 1);
+		num_outside += outside[i] + outside[i + 1] + outside[i + 2] + outside[i + 3];
+	}
+#endif
+
+	// whatever is left over, or everything without SSE
+	for (; i < count; ++i)
+	{
+		outside[i] = (UInt8)(fabsf(xs[i]) > half_width || fabsf(ys[i]) > half_height);
+		num_outside += outside[i];
+	}
+
+	return num_outside;
+}
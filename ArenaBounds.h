@@ -0,0 +1,31 @@
+#ifndef _ARENA_BOUNDS_H
+#define _ARENA_BOUNDS_H
+
+#include <box2d/Box2D.h>
+#include <gef.h>
+
+// the arena edge as a rectangle test instead of four wall bodies
+class ArenaBounds
+{
+public:
+	ArenaBounds();
+
+	void Init(float half_width, float half_height);
+
+	// keeps a body at least margin inside the edge, and stops it moving further out.
+	// returns true if it had to be moved.
+	bool ClampBody(b2Body* body, float margin) const;
+
+	// flags every point outside the arena, or closer than margin to its edge, four at a
+	// time where SSE is available. returns how many were flagged.
+	int TestOutside(const float* xs, const float* ys, int count, UInt8* outside, float margin = 0.0f) const;
+
+	inline float half_width() const { return half_width_; }
+	inline float half_height() const { return half_height_; }
+
+private:
+	float half_width_;
+	float half_height_;
+};
+
+#endif // _ARENA_BOUNDS_H
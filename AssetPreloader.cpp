@@ -0,0 +1,218 @@
+#include "AssetPreloader.h"
+#include "MemoryTracker.h"
+#include <assets/png_loader.h>
+#include <graphics/image_data.h>
+#include <graphics/scene.h>
+#include <graphics/texture.h>
+#include <system/platform.h>
+#include <system/debug_log.h>
+
+AssetPreloader::AssetPreloader(gef::Platform& platform) :
+	platform_(platform),
+	stopping_(false),
+	hits_(0),
+	misses_(0)
+{
+}
+
+AssetPreloader::~AssetPreloader()
+{
+	Stop();
+}
+
+void AssetPreloader::Start()
+{
+	if (thread_.joinable())
+		return;
+
+	stopping_ = false;
+	thread_ = std::thread(&AssetPreloader::Run, this);
+}
+
+void AssetPreloader::Stop()
+{
+	if (thread_.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		work_ready_.notify_all();
+		thread_.join();
+	}
+
+	Clear();
+}
+
+void AssetPreloader::RequestTexture(const char* filename)
+{
+	AddRequest(REQUEST_TEXTURE, filename);
+}
+
+void AssetPreloader::RequestScene(const char* filename)
+{
+	AddRequest(REQUEST_SCENE, filename);
+}
+
+void AssetPreloader::AddRequest(RequestType type, const char* filename)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (std::list<Request>::iterator request = requests_.begin(); request != requests_.end(); ++request)
+		{
+			if (request->type == type && request->filename == filename)
+				return;
+		}
+
+		Request request;
+		request.type = type;
+		request.filename = filename;
+		request.image = NULL;
+		request.scene = NULL;
+		request.started = false;
+		request.done = false;
+		requests_.push_back(request);
+	}
+
+	work_ready_.notify_one();
+}
+
+gef::Texture* AssetPreloader::TakeTexture(const char* filename)
+{
+	Request request;
+	if (!TakeRequest(REQUEST_TEXTURE, filename, request) || !request.image)
+		return NULL;
+
+	MemoryTagScope assets_tag(MEMORY_TAG_ASSETS);
+	gef::Texture* texture = gef::Texture::Create(platform_, *request.image);
+	delete request.image;
+
+	return texture;
+}
+
+gef::Scene* AssetPreloader::TakeScene(const char* filename)
+{
+	Request request;
+	if (!TakeRequest(REQUEST_SCENE, filename, request) || !request.scene)
+		return NULL;
+
+	MemoryTagScope assets_tag(MEMORY_TAG_ASSETS);
+	request.scene->CreateMaterials(platform_);
+	request.scene->CreateMeshes(platform_);
+
+	return request.scene;
+}
+
+bool AssetPreloader::TakeRequest(RequestType type, const char* filename, Request& request)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	std::list<Request>::iterator found = requests_.begin();
+	while (found != requests_.end() && !(found->type == type && found->filename == filename))
+		++found;
+
+	// the loader hasn't got to it, so waiting would be no quicker than loading it here
+	if (found == requests_.end() || !found->started)
+	{
+		if (found != requests_.end())
+			requests_.erase(found);
+
+		misses_++;
+		return false;
+	}
+
+	work_done_.wait(lock, [found] { return found->done; });
+
+	request = *found;
+	requests_.erase(found);
+	hits_++;
+
+	return true;
+}
+
+void AssetPreloader::Clear()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	// the one the loader is on can't be pulled out from under it
+	work_done_.wait(lock, [this]
+	{
+		for (std::list<Request>::const_iterator request = requests_.begin(); request != requests_.end(); ++request)
+		{
+			if (request->started && !request->done)
+				return false;
+		}
+		return true;
+	});
+
+	for (std::list<Request>::iterator request = requests_.begin(); request != requests_.end(); ++request)
+		DeleteResult(*request);
+
+	requests_.clear();
+}
+
+void AssetPreloader::DeleteResult(Request& request)
+{
+	delete request.image;
+	request.image = NULL;
+
+	delete request.scene;
+	request.scene = NULL;
+}
+
+void AssetPreloader::Run()
+{
+	// everything the loader thread allocates is asset data
+	MemoryTagScope assets_tag(MEMORY_TAG_ASSETS);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;)
+	{
+		std::list<Request>::iterator next = requests_.end();
+		work_ready_.wait(lock, [this, &next]
+		{
+			for (next = requests_.begin(); next != requests_.end(); ++next)
+			{
+				if (!next->started)
+					return true;
+			}
+			return stopping_;
+		});
+
+		if (stopping_)
+			break;
+
+		next->started = true;
+		const RequestType type = next->type;
+		const std::string filename = next->filename;
+
+		lock.unlock();
+
+		gef::ImageData* image = NULL;
+		gef::Scene* scene = NULL;
+		if (type == REQUEST_TEXTURE)
+		{
+			image = new gef::ImageData();
+			gef::PNGLoader png_loader;
+			png_loader.Load(filename.c_str(), platform_, *image);
+			if (!image->image())
+			{
+				delete image;
+				image = NULL;
+			}
+		}
+		else
+		{
+			scene = ReadCompactScene(platform_, filename.c_str());
+		}
+
+		if (!image && !scene)
+			gef::DebugOut("Preload of %s failed\n", filename.c_str());
+
+		lock.lock();
+		next->image = image;
+		next->scene = scene;
+		next->done = true;
+		work_done_.notify_all();
+	}
+}
@@ -0,0 +1,87 @@
+#ifndef _ASSET_PRELOADER_H
+#define _ASSET_PRELOADER_H
+
+#include "MeshCompaction.h"
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace gef
+{
+	class Platform;
+	class ImageData;
+	class Scene;
+	class Texture;
+}
+
+// decodes pngs and reads scenes on a loader thread ahead of when they're needed.
+// the GPU side (texture, materials and meshes) can only be made on the main thread,
+// so that's left for Take, which is all that's left of the load by then
+class AssetPreloader
+{
+public:
+	AssetPreloader(gef::Platform& platform);
+	~AssetPreloader();
+
+	void Start();
+
+	// drops anything not taken, then joins
+	void Stop();
+
+	// queue a file for the loader thread, asking again before it's taken does nothing
+	void RequestTexture(const char* filename);
+	void RequestScene(const char* filename);
+
+	// finishes a request on the main thread, waiting for the loader if it's not done yet.
+	// NULL if the file was never requested or failed to load, the caller loads it itself then
+	gef::Texture* TakeTexture(const char* filename);
+	gef::Scene* TakeScene(const char* filename);
+
+	// throws away everything not taken yet, waiting out whatever the loader is on
+	void Clear();
+
+	// takes that found a request, and ones that didn't
+	inline UInt32 hits() const { return hits_; }
+	inline UInt32 misses() const { return misses_; }
+
+private:
+	enum RequestType
+	{
+		REQUEST_TEXTURE,
+		REQUEST_SCENE
+	};
+
+	struct Request
+	{
+		RequestType type;
+		std::string filename;
+		gef::ImageData* image;
+		gef::Scene* scene;
+		bool started;
+		bool done;
+	};
+
+	void Run();
+	void AddRequest(RequestType type, const char* filename);
+
+	// waits for the request to finish and removes it, false if there isn't one
+	bool TakeRequest(RequestType type, const char* filename, Request& request);
+	static void DeleteResult(Request& request);
+
+	gef::Platform& platform_;
+	std::thread thread_;
+
+	// a list so the loader can work on a request with the lock released while more are added
+	std::list<Request> requests_;
+	std::mutex mutex_;
+	std::condition_variable work_ready_;
+	std::condition_variable work_done_;
+	bool stopping_;
+
+	UInt32 hits_;
+	UInt32 misses_;
+};
+
+#endif // _ASSET_PRELOADER_H
@@ -0,0 +1,96 @@
+#include "CollisionLayers.h"
+
+static const uint16 kCategories[kNumObjectTypes] =
+{
+	COLLISION_PLAYER,	// PLAYER
+	COLLISION_ENEMY,	// ENEMY
+	COLLISION_BULLET,	// BULLET
+	COLLISION_WALL		// WALL
+};
+
+// bullets only care about what they can hit, nothing collides with itself except
+// enemies on easy where there are few enough of them to keep the pushing about
+static const CollisionLayerTable kEasyLayers =
+{
+	{
+		COLLISION_ENEMY | COLLISION_WALL,										// PLAYER
+		COLLISION_PLAYER | COLLISION_ENEMY | COLLISION_BULLET | COLLISION_WALL,	// ENEMY
+		COLLISION_ENEMY | COLLISION_WALL,										// BULLET
+		COLLISION_PLAYER | COLLISION_ENEMY | COLLISION_BULLET					// WALL
+	}
+};
+
+// hard has too many enemies for them all to be solved against each other,
+// separation steering keeps them apart instead
+static const CollisionLayerTable kHardLayers =
+{
+	{
+		COLLISION_ENEMY | COLLISION_WALL,						// PLAYER
+		COLLISION_PLAYER | COLLISION_BULLET | COLLISION_WALL,	// ENEMY
+		COLLISION_ENEMY | COLLISION_WALL,						// BULLET
+		COLLISION_PLAYER | COLLISION_ENEMY | COLLISION_BULLET	// WALL
+	}
+};
+
+CollisionLayers::CollisionLayers() :
+	table_(&kEasyLayers)
+{
+}
+
+void CollisionLayers::Init(bool hard)
+{
+	table_ = hard ? &kHardLayers : &kEasyLayers;
+}
+
+b2Filter CollisionLayers::FilterFor(OBJECT_TYPE type) const
+{
+	b2Filter filter;
+	filter.categoryBits = kCategories[type];
+	filter.maskBits = table_->masks[type];
+	return filter;
+}
+
+bool CollisionLayers::ApplyBody(b2Body* body, GameObject* game_object, int& num_applied) const
+{
+	bool applied = false;
+	for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+	{
+		if (fixture->GetFilterData().categoryBits != COLLISION_DEFAULT)
+			continue;
+
+		fixture->SetFilterData(FilterFor(game_object->type()));
+		num_applied++;
+		applied = true;
+	}
+
+	return applied;
+}
+
+int CollisionLayers::Apply(b2World* world) const
+{
+	int num_applied = 0;
+
+	for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+	{
+		GameObject* game_object = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
+		if (game_object)
+			ApplyBody(body, game_object, num_applied);
+	}
+
+	return num_applied;
+}
+
+int CollisionLayers::ApplyNew(b2World* world) const
+{
+	int num_applied = 0;
+
+	// bodies without a game object (the ground) never get a filter, so they're stepped over
+	for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+	{
+		GameObject* game_object = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
+		if (game_object && body->GetFixtureList() && !ApplyBody(body, game_object, num_applied))
+			break;
+	}
+
+	return num_applied;
+}
@@ -0,0 +1,51 @@
+#ifndef _COLLISION_LAYERS_H
+#define _COLLISION_LAYERS_H
+
+#include <box2d/Box2D.h>
+#include "game_object.h"
+
+// box2d category bits for each object type, 0x0001 is left as box2d's default
+// so fixtures that haven't been given a layer yet can be spotted
+enum CollisionCategory
+{
+	COLLISION_DEFAULT = 0x0001,
+	COLLISION_PLAYER = 0x0002,
+	COLLISION_ENEMY = 0x0004,
+	COLLISION_BULLET = 0x0008,
+	COLLISION_WALL = 0x0010
+};
+
+const int kNumObjectTypes = 4;
+
+// which categories each object type collides with, indexed by OBJECT_TYPE
+struct CollisionLayerTable
+{
+	uint16 masks[kNumObjectTypes];
+};
+
+class CollisionLayers
+{
+public:
+	CollisionLayers();
+
+	// hard has more enemies than can be solved against each other
+	void Init(bool hard);
+
+	// gives every fixture still on the default category the filter for its object type,
+	// the managers create their own fixtures so this runs over the world after they do
+	int Apply(b2World* world) const;
+
+	// the same for bodies created since the last call. box2d links new bodies in at the
+	// head of its list, so this stops at the first one it has already given a filter
+	int ApplyNew(b2World* world) const;
+
+	b2Filter FilterFor(OBJECT_TYPE type) const;
+
+private:
+	// false if every fixture already had a filter
+	bool ApplyBody(b2Body* body, GameObject* game_object, int& num_applied) const;
+
+	const CollisionLayerTable* table_;
+};
+
+#endif // _COLLISION_LAYERS_H
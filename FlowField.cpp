@@ -0,0 +1,186 @@
+#include "FlowField.h"
+#include <math.h>
+#include <algorithm>
+
+static const UInt16 kUnreachable = 0xffff;
+
+// 8 neighbours, orthogonal ones first
+static const int kNeighbourX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int kNeighbourY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+FlowField::FlowField() :
+	half_width_(0.0f),
+	half_height_(0.0f),
+	cell_size_(1.0f),
+	inv_cell_size_(1.0f),
+	cells_x_(0),
+	cells_y_(0),
+	target_cell_(-1),
+	target_(0.0f, 0.0f),
+	has_obstacles_(false),
+	rebuild_count_(0)
+{
+}
+
+void FlowField::Init(float half_width, float half_height, float cell_size)
+{
+	half_width_ = half_width;
+	half_height_ = half_height;
+	cell_size_ = cell_size;
+	inv_cell_size_ = 1.0f / cell_size;
+	cells_x_ = (int)ceilf(2.0f * half_width * inv_cell_size_);
+	cells_y_ = (int)ceilf(2.0f * half_height * inv_cell_size_);
+
+	const int num_cells = cells_x_ * cells_y_;
+	blocked_.assign(num_cells, 0);
+	cost_.assign(num_cells, kUnreachable);
+	directions_.assign(num_cells, b2Vec2(0.0f, 0.0f));
+	open_.resize(num_cells);
+
+	target_cell_ = -1;
+	has_obstacles_ = false;
+	rebuild_count_ = 0;
+}
+
+int FlowField::CellIndex(const b2Vec2& position) const
+{
+	int x = (int)((position.x + half_width_) * inv_cell_size_);
+	int y = (int)((position.y + half_height_) * inv_cell_size_);
+
+	x = std::max(0, std::min(x, cells_x_ - 1));
+	y = std::max(0, std::min(y, cells_y_ - 1));
+
+	return y * cells_x_ + x;
+}
+
+b2Vec2 FlowField::CellCentre(int x, int y) const
+{
+	return b2Vec2((x + 0.5f) * cell_size_ - half_width_, (y + 0.5f) * cell_size_ - half_height_);
+}
+
+void FlowField::Block(const b2Vec2& lower, const b2Vec2& upper)
+{
+	const int lower_cell = CellIndex(lower);
+	const int upper_cell = CellIndex(upper);
+
+	for (int y = lower_cell / cells_x_; y <= upper_cell / cells_x_; ++y)
+	{
+		for (int x = lower_cell % cells_x_; x <= upper_cell % cells_x_; ++x)
+			blocked_[y * cells_x_ + x] = 1;
+	}
+
+	has_obstacles_ = true;
+	target_cell_ = -1;
+}
+
+void FlowField::SetTarget(const b2Vec2& target)
+{
+	target_ = target;
+
+	const int cell = CellIndex(target);
+	if (cell == target_cell_)
+		return;
+
+	target_cell_ = cell;
+	if (has_obstacles_)
+		Rebuild();
+}
+
+void FlowField::Rebuild()
+{
+	rebuild_count_++;
+
+	const int num_cells = cells_x_ * cells_y_;
+
+	// breadth first flood out from the target cell
+	std::fill(cost_.begin(), cost_.end(), kUnreachable);
+	int open_head = 0;
+	int open_tail = 0;
+
+	cost_[target_cell_] = 0;
+	open_[open_tail++] = target_cell_;
+
+	while (open_head < open_tail)
+	{
+		const int cell = open_[open_head++];
+		const int cx = cell % cells_x_;
+		const int cy = cell / cells_x_;
+
+		for (int n = 0; n < 8; ++n)
+		{
+			const int nx = cx + kNeighbourX[n];
+			const int ny = cy + kNeighbourY[n];
+			if (nx < 0 || ny < 0 || nx >= cells_x_ || ny >= cells_y_)
+				continue;
+
+			// no cutting corners past an obstacle
+			if (n >= 4 && (blocked_[cy * cells_x_ + nx] || blocked_[ny * cells_x_ + cx]))
+				continue;
+
+			const int neighbour = ny * cells_x_ + nx;
+			if (blocked_[neighbour] || cost_[neighbour] != kUnreachable)
+				continue;
+
+			cost_[neighbour] = cost_[cell] + 1;
+			open_[open_tail++] = neighbour;
+		}
+	}
+
+	// each cell points at its cheapest neighbour
+	for (int cell = 0; cell < num_cells; ++cell)
+	{
+		directions_[cell] = b2Vec2(0.0f, 0.0f);
+		if (cell == target_cell_ || cost_[cell] == kUnreachable)
+			continue;
+
+		const int cx = cell % cells_x_;
+		const int cy = cell / cells_x_;
+		UInt16 best_cost = cost_[cell];
+
+		for (int n = 0; n < 8; ++n)
+		{
+			const int nx = cx + kNeighbourX[n];
+			const int ny = cy + kNeighbourY[n];
+			if (nx < 0 || ny < 0 || nx >= cells_x_ || ny >= cells_y_)
+				continue;
+
+			if (n >= 4 && (blocked_[cy * cells_x_ + nx] || blocked_[ny * cells_x_ + cx]))
+				continue;
+
+			const int neighbour = ny * cells_x_ + nx;
+			if (cost_[neighbour] < best_cost)
+			{
+				best_cost = cost_[neighbour];
+				b2Vec2 direction((float)kNeighbourX[n], (float)kNeighbourY[n]);
+				direction.Normalize();
+				directions_[cell] = direction;
+			}
+		}
+	}
+}
+
+b2Vec2 FlowField::Sample(const b2Vec2& position) const
+{
+	if (target_cell_ < 0)
+		return b2Vec2(0.0f, 0.0f);
+
+	const int cell = CellIndex(position);
+
+	// close enough to home in directly
+	if (cell == target_cell_)
+	{
+		b2Vec2 direction = target_ - position;
+		direction.Normalize();
+		return direction;
+	}
+
+	// nothing in the way, every cell heads straight for the target's cell
+	if (!has_obstacles_)
+	{
+		b2Vec2 direction = CellCentre(target_cell_ % cells_x_, target_cell_ / cells_x_) - CellCentre(cell % cells_x_, cell / cells_x_);
+		direction.Normalize();
+		return direction;
+	}
+
+	return directions_[cell];
+}
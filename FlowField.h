@@ -0,0 +1,54 @@
+#ifndef _FLOW_FIELD_H
+#define _FLOW_FIELD_H
+
+#include <box2d/Box2D.h>
+#include <gef.h>
+#include <vector>
+
+// grid of directions towards a target over the arena, every enemy samples it
+// with a single lookup instead of working out its own path
+class FlowField
+{
+public:
+	FlowField();
+
+	void Init(float half_width, float half_height, float cell_size);
+
+	// mark the cells under an obstacle so the field routes around it
+	void Block(const b2Vec2& lower, const b2Vec2& upper);
+
+	// with nothing blocked there's no field to build, Sample heads straight for the
+	// target's cell. with obstacles the whole field is flooded again when the target
+	// moves into a different cell
+	void SetTarget(const b2Vec2& target);
+
+	// unit direction to move in from position, straight at the target once in its cell
+	// and zero if the target can't be reached
+	b2Vec2 Sample(const b2Vec2& position) const;
+
+	inline int rebuild_count() const { return rebuild_count_; }
+
+private:
+	void Rebuild();
+	int CellIndex(const b2Vec2& position) const;
+	b2Vec2 CellCentre(int x, int y) const;
+
+	float half_width_;
+	float half_height_;
+	float cell_size_;
+	float inv_cell_size_;
+	int cells_x_;
+	int cells_y_;
+
+	int target_cell_;
+	b2Vec2 target_;
+	bool has_obstacles_;
+	int rebuild_count_;
+
+	std::vector<UInt8> blocked_;
+	std::vector<UInt16> cost_;
+	std::vector<int> open_;
+	std::vector<b2Vec2> directions_;
+};
+
+#endif // _FLOW_FIELD_H
@@ -0,0 +1,84 @@
+#include "FramePacer.h"
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+// the OS sleep can be a scheduler tick late, so the last bit is waited out with yields
+static const std::chrono::microseconds kSpinMargin(2000);
+
+FramePacer::FramePacer() :
+	interval_(1.0f / 60.0f),
+	started_(false),
+	sample_cpu_start_(0.0),
+	cpu_ms_per_second_(0.0f)
+{
+}
+
+void FramePacer::Wait()
+{
+	const Clock::time_point now = Clock::now();
+	const Clock::duration interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(interval_));
+
+	if (!started_ || now >= deadline_ + interval)
+	{
+		// first frame, or so far behind that catching up would just spin
+		deadline_ = now + interval;
+		started_ = true;
+	}
+	else
+	{
+		deadline_ += interval;
+	}
+
+	if (deadline_ - kSpinMargin > now)
+		std::this_thread::sleep_until(deadline_ - kSpinMargin);
+
+	while (Clock::now() < deadline_)
+		std::this_thread::yield();
+}
+
+void FramePacer::Sample()
+{
+	const Clock::time_point now = Clock::now();
+	if (sample_start_ == Clock::time_point())
+	{
+		sample_start_ = now;
+		sample_cpu_start_ = ProcessCpuSeconds();
+		return;
+	}
+
+	const double elapsed = std::chrono::duration<double>(now - sample_start_).count();
+	if (elapsed < 1.0)
+		return;
+
+	const double cpu = ProcessCpuSeconds();
+	cpu_ms_per_second_ = (float)((cpu - sample_cpu_start_) * 1000.0 / elapsed);
+
+	sample_start_ = now;
+	sample_cpu_start_ = cpu;
+}
+
+double FramePacer::ProcessCpuSeconds()
+{
+#ifdef _WIN32
+	// clock() is wall time on windows, so ask for the kernel and user time directly
+	FILETIME creation_time, exit_time, kernel_time, user_time;
+	if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+		return 0.0;
+
+	ULARGE_INTEGER kernel, user;
+	kernel.LowPart = kernel_time.dwLowDateTime;
+	kernel.HighPart = kernel_time.dwHighDateTime;
+	user.LowPart = user_time.dwLowDateTime;
+	user.HighPart = user_time.dwHighDateTime;
+
+	// 100ns units
+	return (double)(kernel.QuadPart + user.QuadPart) * 1e-7;
+#else
+	return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
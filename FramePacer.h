@@ -0,0 +1,40 @@
+#ifndef _FRAME_PACER_H
+#define _FRAME_PACER_H
+
+#include <chrono>
+
+// holds the loop to a frame interval by sleeping to a deadline rather than
+// spinning, and keeps track of how much CPU the process uses per second
+class FramePacer
+{
+public:
+	FramePacer();
+
+	inline void set_interval(float interval) { interval_ = interval; }
+	inline float interval() const { return interval_; }
+
+	// sleeps until interval after the last deadline. if the frame overran the
+	// deadline moves to now, so a slow frame doesn't cause a burst of fast ones
+	void Wait();
+
+	// updates the CPU use figure, call once a frame whether pacing or not
+	void Sample();
+
+	// process CPU time (all threads) per second of wall time, over the last second
+	inline float cpu_ms_per_second() const { return cpu_ms_per_second_; }
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	static double ProcessCpuSeconds();
+
+	float interval_;
+	Clock::time_point deadline_;
+	bool started_;
+
+	Clock::time_point sample_start_;
+	double sample_cpu_start_;
+	float cpu_ms_per_second_;
+};
+
+#endif // _FRAME_PACER_H
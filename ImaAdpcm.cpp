@@ -0,0 +1,200 @@
+#include "ImaAdpcm.h"
+#include <cstdio>
+#include <cstring>
+
+static const char kAdpcmMagic[4] = { 'I', 'M', 'A', '1' };
+static const UInt32 kAdpcmHeaderBytes = 16;
+
+static const int kStepTable[89] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+	253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+	1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+	3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+	12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int kIndexTable[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+// the decoder's side of a nibble, the encoder runs it too so both stay in step
+static inline void DecodeNibble(int nibble, int& predictor, int& index)
+{
+	const int step = kStepTable[index];
+
+	int difference = step >> 3;
+	if (nibble & 4) difference += step;
+	if (nibble & 2) difference += step >> 1;
+	if (nibble & 1) difference += step >> 2;
+
+	predictor += (nibble & 8) ? -difference : difference;
+	if (predictor > 32767) predictor = 32767;
+	if (predictor < -32768) predictor = -32768;
+
+	index += kIndexTable[nibble & 7];
+	if (index < 0) index = 0;
+	if (index > 88) index = 88;
+}
+
+static inline int EncodeNibble(int sample, int& predictor, int& index)
+{
+	const int step = kStepTable[index];
+
+	int difference = sample - predictor;
+	int nibble = 0;
+	if (difference < 0)
+	{
+		nibble = 8;
+		difference = -difference;
+	}
+
+	if (difference >= step)
+	{
+		nibble |= 4;
+		difference -= step;
+	}
+	if (difference >= step >> 1)
+	{
+		nibble |= 2;
+		difference -= step >> 1;
+	}
+	if (difference >= step >> 2)
+	{
+		nibble |= 1;
+	}
+
+	DecodeNibble(nibble, predictor, index);
+	return nibble;
+}
+
+static void WriteUInt32(UInt8* bytes, UInt32 value)
+{
+	bytes[0] = (UInt8)value;
+	bytes[1] = (UInt8)(value >> 8);
+	bytes[2] = (UInt8)(value >> 16);
+	bytes[3] = (UInt8)(value >> 24);
+}
+
+static UInt32 ReadUInt32(const UInt8* bytes)
+{
+	return (UInt32)bytes[0] | ((UInt32)bytes[1] << 8) | ((UInt32)bytes[2] << 16) | ((UInt32)bytes[3] << 24);
+}
+
+void EncodeAdpcm(const Int16* frames, UInt32 frame_count, UInt16 channels, UInt32 block_frames, std::vector<UInt8>& data)
+{
+	const UInt32 block_bytes = AdpcmBlockBytes(block_frames);
+	const UInt32 block_count = (frame_count + block_frames - 1) / block_frames;
+	data.assign(block_count * channels * block_bytes, 0);
+
+	for (UInt16 channel = 0; channel < channels; ++channel)
+	{
+		// the step index carries across blocks, the predictor restarts on each one's first sample
+		int index = 0;
+		for (UInt32 block = 0; block < block_count; ++block)
+		{
+			const UInt32 first_frame = block * block_frames;
+			UInt8* out = &data[(block * channels + channel) * block_bytes];
+
+			int predictor = frames[first_frame * channels + channel];
+			out[0] = (UInt8)predictor;
+			out[1] = (UInt8)(predictor >> 8);
+			out[2] = (UInt8)index;
+			out[3] = 0;
+
+			// a short last block holds its final sample to the end
+			int sample = predictor;
+			for (UInt32 frame = 1; frame < block_frames; ++frame)
+			{
+				if (first_frame + frame < frame_count)
+					sample = frames[(first_frame + frame) * channels + channel];
+
+				const int nibble = EncodeNibble(sample, predictor, index);
+				const UInt32 nibble_num = frame - 1;
+				out[4 + nibble_num / 2] |= (UInt8)(nibble << ((nibble_num & 1) * 4));
+			}
+		}
+	}
+}
+
+void DecodeAdpcm(const UInt8* data, UInt32 frame_count, UInt16 channels, UInt32 block_frames, Int16* frames)
+{
+	const UInt32 block_bytes = AdpcmBlockBytes(block_frames);
+	const UInt32 block_count = (frame_count + block_frames - 1) / block_frames;
+
+	for (UInt32 block = 0; block < block_count; ++block)
+	{
+		const UInt32 first_frame = block * block_frames;
+		const UInt32 frames_in_block = frame_count - first_frame < block_frames ? frame_count - first_frame : block_frames;
+
+		for (UInt16 channel = 0; channel < channels; ++channel)
+		{
+			const UInt8* in = data + (block * channels + channel) * block_bytes;
+			int predictor = (Int16)(in[0] | (in[1] << 8));
+			int index = in[2] > 88 ? 88 : in[2];
+
+			Int16* out = frames + first_frame * channels + channel;
+			out[0] = (Int16)predictor;
+
+			// two samples a byte
+			const UInt8* nibbles = in + 4;
+			for (UInt32 frame = 1; frame < frames_in_block; ++frame)
+			{
+				const UInt32 nibble_num = frame - 1;
+				DecodeNibble((nibbles[nibble_num / 2] >> ((nibble_num & 1) * 4)) & 15, predictor, index);
+				out[frame * channels] = (Int16)predictor;
+			}
+		}
+	}
+}
+
+bool WriteAdpcmFile(const char* filename, const AdpcmHeader& header, const std::vector<UInt8>& data)
+{
+	FILE* file = fopen(filename, "wb");
+	if (!file)
+		return false;
+
+	UInt8 bytes[kAdpcmHeaderBytes];
+	memcpy(bytes, kAdpcmMagic, 4);
+	bytes[4] = (UInt8)header.channels;
+	bytes[5] = (UInt8)(header.channels >> 8);
+	bytes[6] = (UInt8)header.block_frames;
+	bytes[7] = (UInt8)(header.block_frames >> 8);
+	WriteUInt32(bytes + 8, header.sample_rate);
+	WriteUInt32(bytes + 12, header.frame_count);
+
+	bool written = fwrite(bytes, sizeof(bytes), 1, file) == 1;
+	if (!data.empty())
+		written = written && fwrite(&data[0], data.size(), 1, file) == 1;
+
+	fclose(file);
+	return written;
+}
+
+bool ReadAdpcmFile(const char* filename, AdpcmHeader& header, std::vector<UInt8>& data)
+{
+	FILE* file = fopen(filename, "rb");
+	if (!file)
+		return false;
+
+	UInt8 bytes[kAdpcmHeaderBytes];
+	bool valid = fread(bytes, sizeof(bytes), 1, file) == 1 && memcmp(bytes, kAdpcmMagic, 4) == 0;
+	if (valid)
+	{
+		header.channels = (UInt16)(bytes[4] | (bytes[5] << 8));
+		header.block_frames = (UInt16)(bytes[6] | (bytes[7] << 8));
+		header.sample_rate = ReadUInt32(bytes + 8);
+		header.frame_count = ReadUInt32(bytes + 12);
+
+		valid = header.channels >= 1 && header.channels <= 2 && header.block_frames >= 2 && (header.block_frames & 1) == 0;
+	}
+
+	if (valid)
+	{
+		const UInt32 block_count = (header.frame_count + header.block_frames - 1) / header.block_frames;
+		data.resize(block_count * header.channels * AdpcmBlockBytes(header.block_frames));
+		valid = data.empty() || fread(&data[0], data.size(), 1, file) == 1;
+	}
+
+	fclose(file);
+	return valid;
+}
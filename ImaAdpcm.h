@@ -0,0 +1,43 @@
+#ifndef _IMA_ADPCM_H
+#define _IMA_ADPCM_H
+
+#include <gef.h>
+#include <vector>
+
+// 4 bit IMA ADPCM, a quarter the size of 16 bit PCM and only a table lookup and a
+// couple of adds a sample to decode. samples are coded in blocks of
+// kAdpcmBlockFrames, each channel of a block starting from an exact sample and the
+// step index, so blocks decode on their own.
+//
+// .adp layout, little endian:
+//   "IMA1", UInt16 channels, UInt16 block_frames, UInt32 sample_rate, UInt32 frame_count
+//   then per block, per channel: Int16 first sample, UInt8 step index, UInt8 pad,
+//   and block_frames - 1 nibbles, low nibble first, padded to a byte
+static const UInt32 kAdpcmBlockFrames = 1024;
+
+struct AdpcmHeader
+{
+	UInt16 channels;
+	UInt16 block_frames;
+	UInt32 sample_rate;
+	UInt32 frame_count;
+};
+
+// bytes one channel of one block takes
+inline UInt32 AdpcmBlockBytes(UInt32 block_frames)
+{
+	return 4 + block_frames / 2;
+}
+
+// interleaved frames in, every block of every channel out
+void EncodeAdpcm(const Int16* frames, UInt32 frame_count, UInt16 channels, UInt32 block_frames, std::vector<UInt8>& data);
+
+// frame_count interleaved frames out, data has to hold all the blocks for them
+void DecodeAdpcm(const UInt8* data, UInt32 frame_count, UInt16 channels, UInt32 block_frames, Int16* frames);
+
+bool WriteAdpcmFile(const char* filename, const AdpcmHeader& header, const std::vector<UInt8>& data);
+
+// false if it's not an .adp or the blocks are cut short
+bool ReadAdpcmFile(const char* filename, AdpcmHeader& header, std::vector<UInt8>& data);
+
+#endif // _IMA_ADPCM_H
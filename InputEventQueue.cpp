@@ -0,0 +1,167 @@
+#include "InputEventQueue.h"
+#include "InputRecorder.h"
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+
+// virtual key for each kRecordedKeys entry, in the same order
+static const int kVirtualKeys[kNumRecordedKeys] =
+{
+	'W', 'A', 'S', 'D', VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT, VK_SPACE, 'R'
+};
+#endif
+
+InputEventQueue::InputEventQueue() :
+	head_(0),
+	tail_(0),
+	dropped_(0)
+{
+}
+
+bool InputEventQueue::Push(const InputEvent& event)
+{
+	const UInt32 tail = tail_.load(std::memory_order_relaxed);
+	if (tail - head_.load(std::memory_order_acquire) >= kCapacity)
+	{
+		dropped_++;
+		return false;
+	}
+
+	events_[tail % kCapacity] = event;
+	tail_.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+void InputEventQueue::PushChanges(UInt16 previous, UInt16 keys, double time)
+{
+	const UInt16 changed = previous ^ keys;
+	for (int key_num = 0; key_num < kNumRecordedKeys; ++key_num)
+	{
+		if (changed & (1 << key_num))
+		{
+			InputEvent event;
+			event.time = time;
+			event.key = (UInt8)key_num;
+			event.down = (keys & (1 << key_num)) != 0;
+			Push(event);
+		}
+	}
+}
+
+int InputEventQueue::Apply(double time, UInt16& keys)
+{
+	UInt32 head = head_.load(std::memory_order_relaxed);
+	const UInt32 tail = tail_.load(std::memory_order_acquire);
+
+	UInt16 changed = 0;
+	int applied = 0;
+	for (; head != tail; ++head)
+	{
+		const InputEvent& event = events_[head % kCapacity];
+		const UInt16 bit = (UInt16)(1 << event.key);
+		if (event.time > time || (changed & bit))
+			break;
+
+		if (event.down)
+			keys |= bit;
+		else
+			keys &= ~bit;
+
+		changed |= bit;
+		applied++;
+	}
+
+	head_.store(head, std::memory_order_release);
+	return applied;
+}
+
+void InputEventQueue::Flush(UInt16& keys)
+{
+	UInt32 head = head_.load(std::memory_order_relaxed);
+	const UInt32 tail = tail_.load(std::memory_order_acquire);
+
+	for (; head != tail; ++head)
+	{
+		const InputEvent& event = events_[head % kCapacity];
+		if (event.down)
+			keys |= (UInt16)(1 << event.key);
+		else
+			keys &= ~(UInt16)(1 << event.key);
+	}
+
+	head_.store(head, std::memory_order_release);
+}
+
+InputPoller::InputPoller() :
+	queue_(NULL),
+	stopping_(false)
+{
+}
+
+InputPoller::~InputPoller()
+{
+	Stop();
+}
+
+#ifdef _WIN32
+bool InputPoller::Start(InputEventQueue* queue)
+{
+	if (thread_.joinable())
+		return true;
+
+	queue_ = queue;
+	stopping_ = false;
+	thread_ = std::thread(&InputPoller::Run, this);
+	return true;
+}
+#else
+bool InputPoller::Start(InputEventQueue*)
+{
+	return false;
+}
+#endif
+
+void InputPoller::Stop()
+{
+	if (!thread_.joinable())
+		return;
+
+	stopping_ = true;
+	thread_.join();
+}
+
+double InputPoller::Now()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void InputPoller::Run()
+{
+#ifdef _WIN32
+	UInt16 previous = 0;
+	while (!stopping_)
+	{
+		// GetAsyncKeyState sees every window's keys, only take them while the game has focus
+		UInt16 keys = 0;
+		DWORD process_id = 0;
+		GetWindowThreadProcessId(GetForegroundWindow(), &process_id);
+		if (process_id == GetCurrentProcessId())
+		{
+			for (int key_num = 0; key_num < kNumRecordedKeys; ++key_num)
+			{
+				if (GetAsyncKeyState(kVirtualKeys[key_num]) & 0x8000)
+					keys |= (UInt16)(1 << key_num);
+			}
+		}
+
+		if (keys != previous)
+		{
+			queue_->PushChanges(previous, keys, Now());
+			previous = keys;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+#endif
+}
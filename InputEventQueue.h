@@ -0,0 +1,74 @@
+#ifndef _INPUT_EVENT_QUEUE_H
+#define _INPUT_EVENT_QUEUE_H
+
+#include <gef.h>
+#include <atomic>
+#include <thread>
+
+// a key going down or up, key is its index in kRecordedKeys
+struct InputEvent
+{
+	double time;
+	UInt8 key;
+	bool down;
+};
+
+// single producer, single consumer ring of key events, no locks. the producer is the
+// input poller thread, or the main thread pushing frame polled changes; the consumer
+// is the fixed step loop, which takes what arrived before the end of each step
+class InputEventQueue
+{
+public:
+	static const UInt32 kCapacity = 256;
+
+	InputEventQueue();
+
+	// producer side, false (and counted) if the consumer has fallen that far behind
+	bool Push(const InputEvent& event);
+
+	// pushes an event for every key whose bit differs between previous and keys
+	void PushChanges(UInt16 previous, UInt16 keys, double time);
+
+	// consumer side. applies the events stamped at or before time to keys, one bit per
+	// kRecordedKeys entry. an event that would undo a change already made in this call
+	// is left for the next one, so a tap shorter than a step still shows in one step
+	int Apply(double time, UInt16& keys);
+
+	// applies everything, for when no steps are running to take them
+	void Flush(UInt16& keys);
+
+	inline UInt32 dropped() const { return dropped_.load(); }
+
+private:
+	InputEvent events_[kCapacity];
+	std::atomic<UInt32> head_;
+	std::atomic<UInt32> tail_;
+	std::atomic<UInt32> dropped_;
+};
+
+// reads the keys on its own thread, asking for a 1ms sleep between polls (how close
+// it gets depends on the OS timer), and queues the changes stamped with when they
+// were seen rather than when the next frame gets round to it
+class InputPoller
+{
+public:
+	InputPoller();
+	~InputPoller();
+
+	// false where keys can't be read off the main thread (only windows can), the
+	// frame polled keyboard has to feed the queue then
+	bool Start(InputEventQueue* queue);
+	void Stop();
+
+	// seconds on the clock events are stamped with
+	static double Now();
+
+private:
+	void Run();
+
+	InputEventQueue* queue_;
+	std::thread thread_;
+	std::atomic<bool> stopping_;
+};
+
+#endif // _INPUT_EVENT_QUEUE_H
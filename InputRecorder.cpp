@@ -0,0 +1,245 @@
+#include "InputRecorder.h"
+#include <system/debug_log.h>
+#include <cstring>
+
+// file layout: header, then one 6 byte record per frame (frame time + key bits)
+static const char kReplayMagic[4] = { 'D', 'U', 'C', 'K' };
+static const UInt32 kReplayVersion = 1;
+static const long kFrameCountOffset = 12;
+
+// frame_time then keys, written one field at a time so there's no padding
+static const long kRecordedFrameSize = sizeof(float) + sizeof(UInt16);
+
+const gef::Keyboard::KeyCode kRecordedKeys[kNumRecordedKeys] =
+{
+	gef::Keyboard::KC_W,
+	gef::Keyboard::KC_A,
+	gef::Keyboard::KC_S,
+	gef::Keyboard::KC_D,
+	gef::Keyboard::KC_UP,
+	gef::Keyboard::KC_DOWN,
+	gef::Keyboard::KC_LEFT,
+	gef::Keyboard::KC_RIGHT,
+	gef::Keyboard::KC_SPACE,
+	gef::Keyboard::KC_R
+};
+
+UInt16 RecordedKeyBits(const gef::Keyboard* keyboard)
+{
+	UInt16 keys = 0;
+	if (keyboard)
+	{
+		for (int key_num = 0; key_num < kNumRecordedKeys; ++key_num)
+		{
+			if (keyboard->IsKeyDown(kRecordedKeys[key_num]))
+				keys |= (UInt16)(1 << key_num);
+		}
+	}
+
+	return keys;
+}
+
+//
+// ScriptedKeyboard
+//
+ScriptedKeyboard::ScriptedKeyboard() :
+	keys_(0),
+	previous_keys_(0)
+{
+}
+
+void ScriptedKeyboard::Update()
+{
+	// state only changes through SetKeys
+}
+
+void ScriptedKeyboard::SetKeys(UInt16 keys)
+{
+	previous_keys_ = keys_;
+	keys_ = keys;
+}
+
+UInt16 ScriptedKeyboard::KeyBit(gef::Keyboard::KeyCode key) const
+{
+	for (int key_num = 0; key_num < kNumRecordedKeys; ++key_num)
+	{
+		if (kRecordedKeys[key_num] == key)
+			return (UInt16)(1 << key_num);
+	}
+
+	return 0;
+}
+
+bool ScriptedKeyboard::IsKeyDown(gef::Keyboard::KeyCode key) const
+{
+	return (keys_ & KeyBit(key)) != 0;
+}
+
+bool ScriptedKeyboard::IsKeyPressed(gef::Keyboard::KeyCode key) const
+{
+	return (keys_ & ~previous_keys_ & KeyBit(key)) != 0;
+}
+
+bool ScriptedKeyboard::IsKeyReleased(gef::Keyboard::KeyCode key) const
+{
+	return (~keys_ & previous_keys_ & KeyBit(key)) != 0;
+}
+
+//
+// ScriptedInputManager
+//
+ScriptedInputManager::ScriptedInputManager(gef::Platform& platform, gef::InputManager* platform_input) :
+	gef::InputManager(platform),
+	platform_input_(platform_input)
+{
+	// share the platform controller and touch input, only the keyboard is scripted
+	controller_manager_ = platform_input_->controller_input();
+	touch_manager_ = platform_input_->touch_manager();
+	keyboard_ = &scripted_keyboard_;
+}
+
+ScriptedInputManager::~ScriptedInputManager()
+{
+	// none of these are owned here, stop the base class deleting them
+	controller_manager_ = NULL;
+	touch_manager_ = NULL;
+	keyboard_ = NULL;
+}
+
+void ScriptedInputManager::Update()
+{
+	// keep the platform side pumping so the controllers stay valid
+	platform_input_->Update();
+}
+
+//
+// InputRecorder
+//
+InputRecorder::InputRecorder() :
+	file_(NULL),
+	seed_(0),
+	frame_count_(0),
+	frame_time_(0.0f),
+	replay_frame_(0)
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+	StopRecording();
+}
+
+bool InputRecorder::StartRecording(const char* filename, UInt32 seed)
+{
+	StopRecording();
+
+	file_ = fopen(filename, "wb");
+	if (!file_)
+	{
+		gef::DebugOut("InputRecorder: could not open %s for writing\n", filename);
+		return false;
+	}
+
+	seed_ = seed;
+	frame_count_ = 0;
+
+	// frame count gets patched in StopRecording
+	fwrite(kReplayMagic, sizeof(kReplayMagic), 1, file_);
+	fwrite(&kReplayVersion, sizeof(UInt32), 1, file_);
+	fwrite(&seed_, sizeof(UInt32), 1, file_);
+	fwrite(&frame_count_, sizeof(UInt32), 1, file_);
+
+	return true;
+}
+
+void InputRecorder::RecordFrame(float frame_time, const gef::Keyboard* keyboard)
+{
+	if (!file_)
+		return;
+
+	UInt16 keys = RecordedKeyBits(keyboard);
+
+	fwrite(&frame_time, sizeof(float), 1, file_);
+	fwrite(&keys, sizeof(UInt16), 1, file_);
+	frame_count_++;
+}
+
+void InputRecorder::StopRecording()
+{
+	if (!file_)
+		return;
+
+	fseek(file_, kFrameCountOffset, SEEK_SET);
+	fwrite(&frame_count_, sizeof(UInt32), 1, file_);
+	fclose(file_);
+	file_ = NULL;
+
+	gef::DebugOut("InputRecorder: recorded %u frames\n", frame_count_);
+}
+
+bool InputRecorder::LoadReplay(const char* filename)
+{
+	frames_.clear();
+	replay_frame_ = 0;
+
+	FILE* file = fopen(filename, "rb");
+	if (!file)
+	{
+		gef::DebugOut("InputRecorder: could not open %s\n", filename);
+		return false;
+	}
+
+	char magic[4];
+	UInt32 version = 0;
+	bool valid = fread(magic, sizeof(magic), 1, file) == 1
+		&& memcmp(magic, kReplayMagic, sizeof(magic)) == 0
+		&& fread(&version, sizeof(UInt32), 1, file) == 1
+		&& version == kReplayVersion
+		&& fread(&seed_, sizeof(UInt32), 1, file) == 1
+		&& fread(&frame_count_, sizeof(UInt32), 1, file) == 1;
+
+	// a truncated or corrupt count would otherwise have the resize below ask for gigabytes
+	if (valid)
+	{
+		const long frames_start = ftell(file);
+		valid = frames_start >= 0 && fseek(file, 0, SEEK_END) == 0;
+
+		const long frames_end = valid ? ftell(file) : -1;
+		valid = frames_end >= frames_start
+			&& (unsigned long)((frames_end - frames_start) / kRecordedFrameSize) >= frame_count_
+			&& fseek(file, frames_start, SEEK_SET) == 0;
+	}
+
+	if (valid)
+	{
+		frames_.resize(frame_count_);
+		for (UInt32 frame_num = 0; frame_num < frame_count_ && valid; ++frame_num)
+		{
+			valid = fread(&frames_[frame_num].frame_time, sizeof(float), 1, file) == 1
+				&& fread(&frames_[frame_num].keys, sizeof(UInt16), 1, file) == 1;
+		}
+	}
+
+	fclose(file);
+
+	if (!valid)
+	{
+		gef::DebugOut("InputRecorder: %s is not a valid replay\n", filename);
+		frames_.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool InputRecorder::ReplayFrame(ScriptedKeyboard& keyboard)
+{
+	if (!replaying())
+		return false;
+
+	const Frame& frame = frames_[replay_frame_++];
+	frame_time_ = frame.frame_time;
+	keyboard.SetKeys(frame.keys);
+
+	return true;
+}
@@ -0,0 +1,102 @@
+#ifndef _INPUT_RECORDER_H
+#define _INPUT_RECORDER_H
+
+#include <gef.h>
+#include <input/input_manager.h>
+#include <input/keyboard.h>
+#include <cstdio>
+#include <vector>
+
+namespace gef
+{
+	class Platform;
+}
+
+// the keys the game actually reads, one bit each in a recorded frame
+// (WASD to move, arrows to shoot, space for the menus, R to rewind).
+// new keys go on the end so older recordings still line up
+const int kNumRecordedKeys = 10;
+extern const gef::Keyboard::KeyCode kRecordedKeys[kNumRecordedKeys];
+
+// one bit per kRecordedKeys entry for the keys that are down
+UInt16 RecordedKeyBits(const gef::Keyboard* keyboard);
+
+// keyboard whose state is set from outside rather than polled from the OS
+class ScriptedKeyboard : public gef::Keyboard
+{
+public:
+	ScriptedKeyboard();
+
+	void Update();
+	bool IsKeyDown(gef::Keyboard::KeyCode key) const;
+	bool IsKeyPressed(gef::Keyboard::KeyCode key) const;
+	bool IsKeyReleased(gef::Keyboard::KeyCode key) const;
+
+	// moves the current keys into the previous frame and sets the new ones
+	void SetKeys(UInt16 keys);
+	inline UInt16 keys() const { return keys_; }
+
+private:
+	UInt16 KeyBit(gef::Keyboard::KeyCode key) const;
+
+	UInt16 keys_;
+	UInt16 previous_keys_;
+};
+
+// stands in for the platform input manager so anything holding an InputManager*
+// (menus, PlayerManager::MovePlayer, BulletManager::CreateNew) sees the replayed keys
+class ScriptedInputManager : public gef::InputManager
+{
+public:
+	ScriptedInputManager(gef::Platform& platform, gef::InputManager* platform_input);
+	~ScriptedInputManager();
+
+	void Update();
+
+	inline ScriptedKeyboard& scripted_keyboard() { return scripted_keyboard_; }
+
+private:
+	gef::InputManager* platform_input_;
+	ScriptedKeyboard scripted_keyboard_;
+};
+
+// records per-frame key state, frame time and the RNG seed to a binary file,
+// or plays one back
+class InputRecorder
+{
+public:
+	InputRecorder();
+	~InputRecorder();
+
+	bool StartRecording(const char* filename, UInt32 seed);
+	void RecordFrame(float frame_time, const gef::Keyboard* keyboard);
+	void StopRecording();
+
+	bool LoadReplay(const char* filename);
+
+	// feeds the next recorded frame into the keyboard, returns false once the replay has run out
+	bool ReplayFrame(ScriptedKeyboard& keyboard);
+
+	inline bool recording() const { return file_ != NULL; }
+	inline bool replaying() const { return replay_frame_ < frames_.size(); }
+	inline UInt32 seed() const { return seed_; }
+	inline float frame_time() const { return frame_time_; }
+	inline UInt32 frame_count() const { return frame_count_; }
+
+private:
+	struct Frame
+	{
+		float frame_time;
+		UInt16 keys;
+	};
+
+	FILE* file_;
+	UInt32 seed_;
+	UInt32 frame_count_;
+	float frame_time_;
+
+	std::vector<Frame> frames_;
+	size_t replay_frame_;
+};
+
+#endif // _INPUT_RECORDER_H
@@ -0,0 +1,139 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem(int num_threads) :
+	queued_(0),
+	remaining_(0),
+	quit_(false)
+{
+	if (num_threads <= 0)
+		num_threads = (int)std::thread::hardware_concurrency();
+	if (num_threads <= 0)
+		num_threads = 1;
+
+	// queue 0 belongs to the calling thread
+	for (int i = 0; i < num_threads; ++i)
+		queues_.push_back(new WorkQueue());
+
+	for (int i = 1; i < num_threads; ++i)
+		workers_.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(wake_mutex_);
+		quit_ = true;
+	}
+	wake_.notify_all();
+
+	for (size_t i = 0; i < workers_.size(); ++i)
+		workers_[i].join();
+
+	for (size_t i = 0; i < queues_.size(); ++i)
+		delete queues_[i];
+}
+
+void JobSystem::ParallelFor(int count, int grain, const RangeFunction& function)
+{
+	if (count <= 0)
+		return;
+
+	if (grain < 1)
+		grain = 1;
+
+	// not worth waking anyone
+	if (queues_.size() == 1 || count <= grain)
+	{
+		function(0, count);
+		return;
+	}
+
+	const int num_jobs = (count + grain - 1) / grain;
+	remaining_ = num_jobs;
+
+	// deal the chunks out round robin, stealing evens out any imbalance
+	for (int job_num = 0; job_num < num_jobs; ++job_num)
+	{
+		Job job;
+		job.function = &function;
+		job.begin = job_num * grain;
+		job.end = job.begin + grain < count ? job.begin + grain : count;
+
+		WorkQueue* queue = queues_[job_num % queues_.size()];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		queue->jobs.push_back(job);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(wake_mutex_);
+		queued_ += num_jobs;
+	}
+	wake_.notify_all();
+
+	// help out until every chunk has finished
+	Job job;
+	while (remaining_ > 0)
+	{
+		if (TakeJob(0, job))
+			RunJob(job);
+		else
+			std::this_thread::yield();
+	}
+}
+
+bool JobSystem::TakeJob(int queue, Job& job)
+{
+	// own queue from the back, it was filled most recently so is warmest in cache
+	{
+		WorkQueue* own = queues_[queue];
+		std::lock_guard<std::mutex> lock(own->mutex);
+		if (!own->jobs.empty())
+		{
+			job = own->jobs.back();
+			own->jobs.pop_back();
+			queued_--;
+			return true;
+		}
+	}
+
+	// steal from the front of everyone else's
+	const int num_queues = (int)queues_.size();
+	for (int offset = 1; offset < num_queues; ++offset)
+	{
+		WorkQueue* victim = queues_[(queue + offset) % num_queues];
+		std::lock_guard<std::mutex> lock(victim->mutex);
+		if (!victim->jobs.empty())
+		{
+			job = victim->jobs.front();
+			victim->jobs.pop_front();
+			queued_--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::RunJob(const Job& job)
+{
+	(*job.function)(job.begin, job.end);
+	remaining_--;
+}
+
+void JobSystem::WorkerLoop(int queue)
+{
+	Job job;
+	while (true)
+	{
+		if (TakeJob(queue, job))
+		{
+			RunJob(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(wake_mutex_);
+		wake_.wait(lock, [this] { return quit_ || queued_ > 0; });
+		if (quit_)
+			return;
+	}
+}
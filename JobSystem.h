@@ -0,0 +1,58 @@
+#ifndef _JOB_SYSTEM_H
+#define _JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// small work stealing job system, each thread has its own queue and takes from
+// the others when it runs dry. the calling thread joins in, so a JobSystem
+// created with one thread just runs everything inline.
+class JobSystem
+{
+public:
+	typedef std::function<void(int begin, int end)> RangeFunction;
+
+	// num_threads counts the calling thread, 0 picks one per hardware thread
+	explicit JobSystem(int num_threads = 0);
+	~JobSystem();
+
+	// splits [0, count) into chunks of grain and blocks until all of them have run.
+	// only call from the thread that owns the JobSystem, not from inside a job.
+	void ParallelFor(int count, int grain, const RangeFunction& function);
+
+	inline int thread_count() const { return (int)queues_.size(); }
+
+private:
+	struct Job
+	{
+		const RangeFunction* function;
+		int begin;
+		int end;
+	};
+
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	void WorkerLoop(int queue);
+	bool TakeJob(int queue, Job& job);
+	void RunJob(const Job& job);
+
+	std::vector<WorkQueue*> queues_;
+	std::vector<std::thread> workers_;
+
+	std::mutex wake_mutex_;
+	std::condition_variable wake_;
+	std::atomic<int> queued_;
+	std::atomic<int> remaining_;
+	bool quit_;
+};
+
+#endif // _JOB_SYSTEM_H
@@ -0,0 +1,190 @@
+#include "LightManager.h"
+#include <graphics/default_3d_shader_data.h>
+#include <math.h>
+#include <algorithm>
+
+LightManager::LightManager() :
+	half_width_(0.0f),
+	half_height_(0.0f),
+	inv_cell_size_(1.0f),
+	cells_x_(1),
+	cells_y_(1),
+	grid_dirty_(true)
+{
+}
+
+void LightManager::Init(float half_width, float half_height, float cell_size)
+{
+	half_width_ = half_width;
+	half_height_ = half_height;
+	inv_cell_size_ = 1.0f / cell_size;
+	cells_x_ = (int)ceilf(2.0f * half_width * inv_cell_size_);
+	cells_y_ = (int)ceilf(2.0f * half_height * inv_cell_size_);
+	if (cells_x_ < 1)
+		cells_x_ = 1;
+	if (cells_y_ < 1)
+		cells_y_ = 1;
+
+	lights_.reserve(kMaxLights);
+	cell_start_.resize(cells_x_ * cells_y_ + 1);
+
+	Clear();
+}
+
+void LightManager::Clear()
+{
+	lights_.clear();
+	global_lights_.clear();
+	grid_dirty_ = true;
+}
+
+int LightManager::AddLight(const gef::PointLight& light, float radius)
+{
+	const gef::Vector4& position = light.position();
+	const gef::Colour& colour = light.colour();
+
+	for (int light_num = 0; light_num < (int)lights_.size(); ++light_num)
+	{
+		const gef::PointLight& existing = lights_[light_num].light;
+		if (existing.position().x() == position.x() && existing.position().y() == position.y() && existing.position().z() == position.z() &&
+			existing.colour().r == colour.r && existing.colour().g == colour.g && existing.colour().b == colour.b &&
+			lights_[light_num].radius == radius)
+		{
+			return light_num;
+		}
+	}
+
+	if ((int)lights_.size() == kMaxLights)
+		return -1;
+
+	Light new_light;
+	new_light.light = light;
+	new_light.position.Set(position.x(), position.y());
+	new_light.radius = radius;
+	new_light.brightness = (colour.r + colour.g + colour.b) / 3.0f;
+
+	const int index = (int)lights_.size();
+	lights_.push_back(new_light);
+
+	if (radius <= 0.0f)
+		global_lights_.push_back(index);
+
+	grid_dirty_ = true;
+	return index;
+}
+
+void LightManager::CellCoords(const b2Vec2& position, int& x, int& y) const
+{
+	x = (int)((position.x + half_width_) * inv_cell_size_);
+	y = (int)((position.y + half_height_) * inv_cell_size_);
+	x = x < 0 ? 0 : (x >= cells_x_ ? cells_x_ - 1 : x);
+	y = y < 0 ? 0 : (y >= cells_y_ ? cells_y_ - 1 : y);
+}
+
+void LightManager::BuildGrid()
+{
+	// count how many local lights reach each cell, then lay the cells out back to back
+	std::fill(cell_start_.begin(), cell_start_.end(), 0);
+
+	for (int light_num = 0; light_num < (int)lights_.size(); ++light_num)
+	{
+		const Light& light = lights_[light_num];
+		if (light.radius <= 0.0f)
+			continue;
+
+		int x0, y0, x1, y1;
+		CellCoords(light.position - b2Vec2(light.radius, light.radius), x0, y0);
+		CellCoords(light.position + b2Vec2(light.radius, light.radius), x1, y1);
+		for (int y = y0; y <= y1; ++y)
+			for (int x = x0; x <= x1; ++x)
+				cell_start_[y * cells_x_ + x + 1]++;
+	}
+
+	for (int cell = 0; cell < cells_x_ * cells_y_; ++cell)
+		cell_start_[cell + 1] += cell_start_[cell];
+
+	cell_lights_.resize(cell_start_[cells_x_ * cells_y_]);
+
+	std::vector<int> cursor(cell_start_.begin(), cell_start_.end() - 1);
+	for (int light_num = 0; light_num < (int)lights_.size(); ++light_num)
+	{
+		const Light& light = lights_[light_num];
+		if (light.radius <= 0.0f)
+			continue;
+
+		int x0, y0, x1, y1;
+		CellCoords(light.position - b2Vec2(light.radius, light.radius), x0, y0);
+		CellCoords(light.position + b2Vec2(light.radius, light.radius), x1, y1);
+		for (int y = y0; y <= y1; ++y)
+			for (int x = x0; x <= x1; ++x)
+				cell_lights_[cursor[y * cells_x_ + x]++] = light_num;
+	}
+
+	grid_dirty_ = false;
+}
+
+int LightManager::Select(const b2Vec2& position, int* lights, int max_lights)
+{
+	if (grid_dirty_)
+		BuildGrid();
+
+	if (max_lights > kMaxLightsPerDraw)
+		max_lights = kMaxLightsPerDraw;
+
+	int num_lights = 0;
+	for (int i = 0; i < (int)global_lights_.size() && num_lights < max_lights; ++i)
+		lights[num_lights++] = global_lights_[i];
+
+	const int num_globals = num_lights;
+	float scores[kMaxLightsPerDraw];
+
+	int x, y;
+	CellCoords(position, x, y);
+	const int cell = y * cells_x_ + x;
+
+	for (int i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i)
+	{
+		const Light& light = lights_[cell_lights_[i]];
+		const float distance = (light.position - position).Length();
+		if (distance >= light.radius)
+			continue;
+
+		// brighter and closer wins, falling off to nothing at the radius
+		const float falloff = 1.0f - distance / light.radius;
+		const float score = light.brightness * falloff * falloff;
+
+		// insertion into the local slots, kept sorted best first
+		int slot = num_lights;
+		while (slot > num_globals && scores[slot - num_globals - 1] < score)
+			slot--;
+
+		if (slot >= max_lights)
+			continue;
+
+		const int last = num_lights < max_lights ? num_lights : max_lights - 1;
+		for (int move = last; move > slot; --move)
+		{
+			lights[move] = lights[move - 1];
+			scores[move - num_globals] = scores[move - num_globals - 1];
+		}
+
+		lights[slot] = cell_lights_[i];
+		scores[slot - num_globals] = score;
+		if (num_lights < max_lights)
+			num_lights++;
+	}
+
+	return num_lights;
+}
+
+int LightManager::Apply(gef::Default3DShaderData& shader_data, const b2Vec2& position)
+{
+	int selected[kMaxLightsPerDraw];
+	const int num_selected = Select(position, selected, kMaxLightsPerDraw);
+
+	shader_data.CleanUp();
+	for (int i = 0; i < num_selected; ++i)
+		shader_data.AddPointLight(lights_[selected[i]].light);
+
+	return num_selected;
+}
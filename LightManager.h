@@ -0,0 +1,71 @@
+#ifndef _LIGHT_MANAGER_H
+#define _LIGHT_MANAGER_H
+
+#include <graphics/point_light.h>
+#include <box2d/Box2D.h>
+#include <vector>
+
+namespace gef
+{
+	class Default3DShaderData;
+}
+
+// the shader only has room for kMaxLightsPerDraw lights, so the manager keeps the
+// whole scene's lights and hands the shader the ones that matter for each draw.
+// local lights are bucketed into a grid over the arena so picking them is a
+// lookup in one cell rather than a pass over every light.
+class LightManager
+{
+public:
+	// matches NUM_LIGHTS in the default shaders
+	static const int kMaxLightsPerDraw = 4;
+	static const int kMaxLights = 64;
+
+	LightManager();
+
+	// half_width / half_height cover the arena, anything outside is clamped into the edge cells
+	void Init(float half_width, float half_height, float cell_size);
+	void Clear();
+
+	// radius <= 0 is a global light that every draw gets, otherwise it only reaches
+	// that far. adding a light that's already there gives back the existing one, so
+	// running the setup twice can't stack them up. -1 if the set is full.
+	int AddLight(const gef::PointLight& light, float radius);
+
+	// the most relevant lights for something at position, globals first, at most
+	// kMaxLightsPerDraw. returns how many
+	int Select(const b2Vec2& position, int* lights, int max_lights);
+
+	// replaces the shader's lights with the ones selected for position, returns how many
+	int Apply(gef::Default3DShaderData& shader_data, const b2Vec2& position);
+
+	inline int light_count() const { return (int)lights_.size(); }
+
+private:
+	struct Light
+	{
+		gef::PointLight light;
+		b2Vec2 position;
+		float radius;
+		float brightness;
+	};
+
+	void BuildGrid();
+	void CellCoords(const b2Vec2& position, int& x, int& y) const;
+
+	std::vector<Light> lights_;
+	std::vector<int> global_lights_;
+
+	float half_width_;
+	float half_height_;
+	float inv_cell_size_;
+	int cells_x_;
+	int cells_y_;
+
+	// cell_start_[c]..cell_start_[c+1] index into cell_lights_
+	std::vector<int> cell_start_;
+	std::vector<int> cell_lights_;
+	bool grid_dirty_;
+};
+
+#endif // _LIGHT_MANAGER_H
@@ -0,0 +1,71 @@
+#include "LinearArena.h"
+#include <cstdlib>
+
+LinearArena::LinearArena() :
+	memory_(NULL),
+	capacity_(0),
+	offset_(0),
+	high_water_mark_(0),
+	overflow_bytes_(0)
+{
+}
+
+LinearArena::~LinearArena()
+{
+	Release();
+}
+
+void LinearArena::Init(size_t capacity)
+{
+	Release();
+
+	memory_ = static_cast<UInt8*>(malloc(capacity));
+	capacity_ = memory_ ? capacity : 0;
+}
+
+void LinearArena::Release()
+{
+	free(memory_);
+	memory_ = NULL;
+	capacity_ = 0;
+	offset_ = 0;
+	high_water_mark_ = 0;
+	overflow_bytes_ = 0;
+}
+
+void* LinearArena::Alloc(size_t size, size_t alignment)
+{
+	if (!memory_)
+		return NULL;
+
+	// align the address rather than the offset, malloc only promises so much
+	const size_t address = reinterpret_cast<size_t>(memory_) + offset_;
+	const size_t aligned = (address + alignment - 1) & ~(alignment - 1);
+	const size_t start = aligned - reinterpret_cast<size_t>(memory_);
+
+	if (start + size > capacity_)
+		return NULL;
+
+	offset_ = start + size;
+	if (offset_ > high_water_mark_)
+		high_water_mark_ = offset_;
+
+	return memory_ + start;
+}
+
+void LinearArena::Reset()
+{
+	offset_ = 0;
+}
+
+void LinearArena::ResetTo(size_t mark)
+{
+	if (mark < offset_)
+		offset_ = mark;
+}
+
+bool LinearArena::Owns(const void* pointer) const
+{
+	const UInt8* bytes = static_cast<const UInt8*>(pointer);
+	return memory_ && bytes >= memory_ && bytes < memory_ + capacity_;
+}
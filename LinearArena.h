@@ -0,0 +1,73 @@
+#ifndef _LINEAR_ARENA_H
+#define _LINEAR_ARENA_H
+
+#include <gef.h>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// one block handed out front to back and given back all at once with Reset.
+// anything that doesn't fit goes to the heap instead, Delete knows which is which,
+// and the overflow shows up in overflow_bytes() so the block can be resized.
+class LinearArena
+{
+public:
+	LinearArena();
+	~LinearArena();
+
+	void Init(size_t capacity);
+	void Release();
+
+	// NULL if the block is full
+	void* Alloc(size_t size, size_t alignment);
+
+	// only resets the offset, destructors are the caller's job (see Delete)
+	void Reset();
+
+	// gives back everything allocated since used() returned mark, keeping what came before
+	void ResetTo(size_t mark);
+
+	// for allocators built on top that fell back to the heap
+	inline void AddOverflow(size_t size) { overflow_bytes_ += size; }
+
+	bool Owns(const void* pointer) const;
+
+	template<typename T, typename... Args>
+	T* New(Args&&... args)
+	{
+		void* memory = Alloc(sizeof(T), alignof(T));
+		if (!memory)
+		{
+			overflow_bytes_ += sizeof(T);
+			return new T(std::forward<Args>(args)...);
+		}
+
+		return new (memory) T(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	void Delete(T* object)
+	{
+		if (!object)
+			return;
+
+		if (Owns(object))
+			object->~T();
+		else
+			delete object;
+	}
+
+	inline size_t capacity() const { return capacity_; }
+	inline size_t used() const { return offset_; }
+	inline size_t high_water_mark() const { return high_water_mark_; }
+	inline size_t overflow_bytes() const { return overflow_bytes_; }
+
+private:
+	UInt8* memory_;
+	size_t capacity_;
+	size_t offset_;
+	size_t high_water_mark_;
+	size_t overflow_bytes_;
+};
+
+#endif // _LINEAR_ARENA_H
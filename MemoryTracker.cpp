@@ -0,0 +1,240 @@
+#include "MemoryTracker.h"
+#include "LinearArena.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// size and tag in front of every block, 16 bytes so the block itself keeps malloc's alignment
+struct AllocationHeader
+{
+	size_t size;
+	UInt32 tag;
+	UInt32 magic;
+};
+
+static const size_t kHeaderSize = 16;
+static const UInt32 kHeaderMagic = 0x6d656d21;
+static const UInt32 kArenaHeaderMagic = 0x6172656e;
+static_assert(sizeof(AllocationHeader) <= kHeaderSize, "allocation header doesn't fit");
+
+// zero initialised before any constructor runs, so allocations from other static
+// initialisers are counted safely
+static std::atomic<size_t> live_bytes_[NUM_MEMORY_TAGS];
+static std::atomic<size_t> peak_bytes_[NUM_MEMORY_TAGS];
+static std::atomic<UInt32> allocations_[NUM_MEMORY_TAGS];
+
+// only touched by the thread calling EndFrame
+static UInt32 last_frame_allocations_[NUM_MEMORY_TAGS];
+static UInt32 frame_allocations_[NUM_MEMORY_TAGS];
+
+static thread_local MemoryTag current_tag_ = MEMORY_TAG_UNTAGGED;
+static thread_local LinearArena* current_arena_ = NULL;
+
+static const char* kTagNames[NUM_MEMORY_TAGS] =
+{
+	"untagged",
+	"assets",
+	"physics",
+	"render",
+	"audio",
+	"ui",
+	"gameplay"
+};
+
+static void* TrackedAlloc(size_t size)
+{
+	void* block = NULL;
+	LinearArena* arena = current_arena_;
+	if (arena)
+	{
+		block = arena->Alloc(kHeaderSize + size, kHeaderSize);
+		if (!block)
+			arena->AddOverflow(kHeaderSize + size);
+	}
+
+	const bool from_arena = block != NULL;
+	if (!block)
+		block = malloc(kHeaderSize + size);
+	if (!block)
+		return NULL;
+
+	const MemoryTag tag = current_tag_;
+
+	AllocationHeader* header = static_cast<AllocationHeader*>(block);
+	header->size = size;
+	header->tag = (UInt32)tag;
+	header->magic = from_arena ? kArenaHeaderMagic : kHeaderMagic;
+
+	const size_t live = live_bytes_[tag].fetch_add(size, std::memory_order_relaxed) + size;
+	allocations_[tag].fetch_add(1, std::memory_order_relaxed);
+
+	size_t peak = peak_bytes_[tag].load(std::memory_order_relaxed);
+	while (live > peak && !peak_bytes_[tag].compare_exchange_weak(peak, live, std::memory_order_relaxed))
+	{
+	}
+
+	return static_cast<UInt8*>(block) + kHeaderSize;
+}
+
+static void TrackedFree(void* pointer)
+{
+	if (!pointer)
+		return;
+
+	void* block = static_cast<UInt8*>(pointer) - kHeaderSize;
+	AllocationHeader* header = static_cast<AllocationHeader*>(block);
+
+	// charged to the tag it was allocated under, whatever the current one is
+	const bool from_arena = header->magic == kArenaHeaderMagic;
+	if ((header->magic == kHeaderMagic || from_arena) && header->tag < NUM_MEMORY_TAGS)
+	{
+		live_bytes_[header->tag].fetch_sub(header->size, std::memory_order_relaxed);
+	}
+
+	header->magic = 0;
+
+	// arena blocks go back when the arena is reset
+	if (!from_arena)
+		free(block);
+}
+
+//
+// MemoryTracker
+//
+MemoryTag MemoryTracker::current_tag()
+{
+	return current_tag_;
+}
+
+void MemoryTracker::set_current_tag(MemoryTag tag)
+{
+	current_tag_ = tag;
+}
+
+MemoryTagStats MemoryTracker::Stats(MemoryTag tag)
+{
+	MemoryTagStats stats;
+	stats.live_bytes = live_bytes_[tag].load(std::memory_order_relaxed);
+	stats.peak_bytes = peak_bytes_[tag].load(std::memory_order_relaxed);
+	stats.allocations = allocations_[tag].load(std::memory_order_relaxed);
+	stats.frame_allocations = frame_allocations_[tag];
+	return stats;
+}
+
+const char* MemoryTracker::TagName(MemoryTag tag)
+{
+	return kTagNames[tag];
+}
+
+void MemoryTracker::EndFrame()
+{
+	for (int tag = 0; tag < NUM_MEMORY_TAGS; ++tag)
+	{
+		const UInt32 allocations = allocations_[tag].load(std::memory_order_relaxed);
+		frame_allocations_[tag] = allocations - last_frame_allocations_[tag];
+		last_frame_allocations_[tag] = allocations;
+	}
+}
+
+bool MemoryTracker::Dump(const char* filename)
+{
+	FILE* file = fopen(filename, "w");
+	if (!file)
+		return false;
+
+	fprintf(file, "tag,live_bytes,peak_bytes,allocations,last_frame_allocations\n");
+	for (int tag = 0; tag < NUM_MEMORY_TAGS; ++tag)
+	{
+		const MemoryTagStats stats = Stats((MemoryTag)tag);
+		fprintf(file, "%s,%u,%u,%u,%u\n", kTagNames[tag], (UInt32)stats.live_bytes, (UInt32)stats.peak_bytes,
+			stats.allocations, stats.frame_allocations);
+	}
+
+	fclose(file);
+	return true;
+}
+
+//
+// MemoryTagScope
+//
+MemoryTagScope::MemoryTagScope(MemoryTag tag) :
+	previous_tag_(current_tag_)
+{
+	current_tag_ = tag;
+}
+
+MemoryTagScope::~MemoryTagScope()
+{
+	current_tag_ = previous_tag_;
+}
+
+//
+// MemoryArenaScope
+//
+MemoryArenaScope::MemoryArenaScope(LinearArena* arena) :
+	previous_arena_(current_arena_)
+{
+	current_arena_ = arena;
+}
+
+MemoryArenaScope::~MemoryArenaScope()
+{
+	current_arena_ = previous_arena_;
+}
+
+//
+// global new / delete
+//
+void* operator new(size_t size)
+{
+	void* pointer = TrackedAlloc(size);
+	if (!pointer)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return TrackedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return TrackedAlloc(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pointer);
+}
@@ -0,0 +1,75 @@
+#ifndef _MEMORY_TRACKER_H
+#define _MEMORY_TRACKER_H
+
+#include <gef.h>
+#include <cstddef>
+
+class LinearArena;
+
+// what an allocation is charged to, set for the current thread with a MemoryTagScope
+enum MemoryTag
+{
+	MEMORY_TAG_UNTAGGED,
+	MEMORY_TAG_ASSETS,
+	MEMORY_TAG_PHYSICS,
+	MEMORY_TAG_RENDER,
+	MEMORY_TAG_AUDIO,
+	MEMORY_TAG_UI,
+	MEMORY_TAG_GAMEPLAY,
+	NUM_MEMORY_TAGS
+};
+
+struct MemoryTagStats
+{
+	size_t live_bytes;
+	size_t peak_bytes;
+	UInt32 allocations;			// since startup
+	UInt32 frame_allocations;	// in the last frame passed to EndFrame
+};
+
+// global operator new / delete are replaced in MemoryTracker.cpp, each block carries
+// a small header with its size and tag so the counts can be kept per tag.
+// only new / delete is seen, malloc (Box2D's b2Alloc, most of gef's internals) isn't.
+// inside a MemoryArenaScope the blocks come out of a LinearArena instead of the heap.
+class MemoryTracker
+{
+public:
+	static MemoryTag current_tag();
+	static void set_current_tag(MemoryTag tag);
+
+	static MemoryTagStats Stats(MemoryTag tag);
+	static const char* TagName(MemoryTag tag);
+
+	// call once a frame to latch how many allocations each tag made during it
+	static void EndFrame();
+
+	// one line per tag, returns false if the file couldn't be written
+	static bool Dump(const char* filename);
+};
+
+// charges everything allocated on this thread to tag until it goes out of scope
+class MemoryTagScope
+{
+public:
+	explicit MemoryTagScope(MemoryTag tag);
+	~MemoryTagScope();
+
+private:
+	MemoryTag previous_tag_;
+};
+
+// everything new'd on this thread comes out of arena until it goes out of scope, still
+// charged to the current tag. deleting one of those blocks gives nothing back, the
+// arena gets it all back on Reset, so none of them can be deleted after that.
+// when the arena is full the heap is used and the arena's overflow counts it.
+class MemoryArenaScope
+{
+public:
+	explicit MemoryArenaScope(LinearArena* arena);
+	~MemoryArenaScope();
+
+private:
+	LinearArena* previous_arena_;
+};
+
+#endif // _MEMORY_TRACKER_H
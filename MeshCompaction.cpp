@@ -0,0 +1,69 @@
+#include "MeshCompaction.h"
+#include "MemoryTracker.h"
+#include <graphics/scene.h>
+#include <graphics/mesh_data.h>
+#include <system/platform.h>
+#include <system/debug_log.h>
+
+void CompactMeshData(gef::MeshData& mesh_data, MeshCompactionStats& stats)
+{
+	gef::VertexData& vertex_data = mesh_data.vertex_data;
+	const int num_vertices = vertex_data.num_vertices;
+
+	stats.original_bytes += num_vertices * vertex_data.vertex_byte_size;
+	stats.compact_bytes += num_vertices * vertex_data.vertex_byte_size;
+
+	const UInt32 index_byte_size = IndexByteSizeFor(num_vertices);
+
+	for (size_t primitive_num = 0; primitive_num < mesh_data.primitives.size(); ++primitive_num)
+	{
+		gef::PrimitiveData* primitive = mesh_data.primitives[primitive_num];
+		stats.original_bytes += primitive->num_indices * primitive->index_byte_size;
+
+		if (primitive->index_byte_size == sizeof(UInt32) && index_byte_size == sizeof(UInt16))
+		{
+			const UInt32* source = (const UInt32*)primitive->indices;
+			UInt16* dest = (UInt16*)primitive->indices;
+			for (Int32 index_num = 0; index_num < primitive->num_indices; ++index_num)
+				dest[index_num] = (UInt16)source[index_num];
+
+			primitive->index_byte_size = sizeof(UInt16);
+		}
+
+		stats.compact_bytes += primitive->num_indices * primitive->index_byte_size;
+	}
+}
+
+gef::Scene* LoadCompactScene(gef::Platform& platform, const char* filename)
+{
+	gef::Scene* scene = ReadCompactScene(platform, filename);
+	if (!scene)
+		return NULL;
+
+	MemoryTagScope assets_tag(MEMORY_TAG_ASSETS);
+	scene->CreateMaterials(platform);
+	scene->CreateMeshes(platform);
+
+	return scene;
+}
+
+gef::Scene* ReadCompactScene(const gef::Platform& platform, const char* filename)
+{
+	MemoryTagScope assets_tag(MEMORY_TAG_ASSETS);
+
+	gef::Scene* scene = new gef::Scene();
+
+	if (!scene->ReadSceneFromFile(platform, filename))
+	{
+		delete scene;
+		return NULL;
+	}
+
+	MeshCompactionStats stats = { 0, 0 };
+	for (std::list<gef::MeshData>::iterator mesh_data = scene->mesh_data.begin(); mesh_data != scene->mesh_data.end(); ++mesh_data)
+		CompactMeshData(*mesh_data, stats);
+
+	gef::DebugOut("%s: mesh data %u bytes -> %u bytes\n", filename, stats.original_bytes, stats.compact_bytes);
+
+	return scene;
+}
@@ -0,0 +1,37 @@
+#ifndef _MESH_COMPACTION_H
+#define _MESH_COMPACTION_H
+
+#include <gef.h>
+
+namespace gef
+{
+	class Platform;
+	class Scene;
+	struct MeshData;
+}
+
+struct MeshCompactionStats
+{
+	UInt32 original_bytes;
+	UInt32 compact_bytes;
+};
+
+// 16 bit indices are enough for anything under 65536 vertices
+inline UInt32 IndexByteSizeFor(int num_vertices)
+{
+	return num_vertices <= 0x10000 ? sizeof(UInt16) : sizeof(UInt32);
+}
+
+// narrows 32 bit indices to 16 bit where the vertex count allows. works in place,
+// the narrowed data always fits in the original buffers. vertices keep gef's float
+// layout, the stock 3D shader's input layout is fixed inside the engine
+void CompactMeshData(gef::MeshData& mesh_data, MeshCompactionStats& stats);
+
+// gef::Scene load that compacts the mesh data before the GPU buffers are created
+gef::Scene* LoadCompactScene(gef::Platform& platform, const char* filename);
+
+// the file read and compaction half of LoadCompactScene, with no GPU resources made.
+// safe off the main thread, CreateMaterials / CreateMeshes still have to be called on it
+gef::Scene* ReadCompactScene(const gef::Platform& platform, const char* filename);
+
+#endif // _MESH_COMPACTION_H
@@ -0,0 +1,224 @@
+#include "MusicStream.h"
+#include "MemoryTracker.h"
+#include <system/debug_log.h>
+#include <chrono>
+
+static const UInt32 kRingFrames = MusicStream::kChunkFrames * MusicStream::kNumChunks;
+
+MusicStream::MusicStream() :
+	file_(NULL),
+	data_read_(0),
+	looping_(false),
+	write_frame_(0),
+	read_frame_(0),
+	finished_(false),
+	underruns_(0),
+	fraction_(0.0),
+	stopping_(false)
+{
+	format_.sample_rate = 0;
+}
+
+MusicStream::~MusicStream()
+{
+	Close();
+}
+
+bool MusicStream::Open(const char* filename, bool looping)
+{
+	MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+	Close();
+
+	file_ = fopen(filename, "rb");
+	if (!file_)
+	{
+		gef::DebugOut("Could not open %s\n", filename);
+		return false;
+	}
+
+	if (!ReadWavHeader(file_, format_) || format_.data_size < format_.bytes_per_frame())
+	{
+		gef::DebugOut("%s: only 8 or 16 bit PCM wav, mono or stereo\n", filename);
+		fclose(file_);
+		file_ = NULL;
+		return false;
+	}
+
+	looping_ = looping;
+	data_read_ = 0;
+	file_chunk_.resize(kChunkFrames * format_.bytes_per_frame());
+	ring_.assign(kRingFrames * 2, 0);
+	write_frame_ = 0;
+	read_frame_ = 0;
+	finished_ = false;
+	underruns_ = 0;
+	fraction_ = 0.0;
+	stopping_ = false;
+
+	thread_ = std::thread(&MusicStream::Run, this);
+	return true;
+}
+
+void MusicStream::Close()
+{
+	if (thread_.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		space_ready_.notify_one();
+		thread_.join();
+	}
+
+	if (file_)
+	{
+		fclose(file_);
+		file_ = NULL;
+	}
+}
+
+UInt32 MusicStream::Mix(float* out, UInt32 frame_count, UInt32 output_rate, float volume)
+{
+	if (!is_open() || output_rate == 0)
+		return 0;
+
+	const UInt32 read_frame = read_frame_.load(std::memory_order_relaxed);
+	const UInt32 available = write_frame_.load(std::memory_order_acquire) - read_frame;
+	const float scale = volume / 32768.0f;
+
+	UInt32 mix_frames = 0;
+	UInt32 consumed = 0;
+	if (format_.sample_rate == output_rate)
+	{
+		mix_frames = frame_count < available ? frame_count : available;
+		for (UInt32 frame = 0; frame < mix_frames; ++frame)
+		{
+			const Int16* ring_frame = &ring_[((read_frame + frame) % kRingFrames) * 2];
+			out[frame * 2] += ring_frame[0] * scale;
+			out[frame * 2 + 1] += ring_frame[1] * scale;
+		}
+		consumed = mix_frames;
+	}
+	else
+	{
+		// linear between the frames either side, as MixVoice does for the effects. an output
+		// frame needs the source frame after it too, so the last one ready waits for the next
+		const double step = (double)format_.sample_rate / (double)output_rate;
+		double position = fraction_;
+		for (; mix_frames < frame_count; ++mix_frames, position += step)
+		{
+			const UInt32 index = (UInt32)position;
+			if (index + 1 >= available)
+				break;
+
+			const float t = (float)(position - index);
+			const Int16* a = &ring_[((read_frame + index) % kRingFrames) * 2];
+			const Int16* b = &ring_[((read_frame + index + 1) % kRingFrames) * 2];
+			out[mix_frames * 2] += (a[0] + (b[0] - a[0]) * t) * scale;
+			out[mix_frames * 2 + 1] += (a[1] + (b[1] - a[1]) * t) * scale;
+		}
+
+		// a step over 2 can carry the position past what's ready, that part waits in the fraction
+		consumed = (UInt32)position < available ? (UInt32)position : available;
+		fraction_ = position - consumed;
+	}
+
+	read_frame_.store(read_frame + consumed, std::memory_order_release);
+	space_ready_.notify_one();
+
+	if (mix_frames < frame_count && !finished_)
+		underruns_++;
+
+	return mix_frames;
+}
+
+bool MusicStream::ReadChunk(Int16* frames, UInt32 frame_count, UInt32& frames_read)
+{
+	const UInt32 bytes_per_frame = format_.bytes_per_frame();
+	frames_read = 0;
+
+	while (frames_read < frame_count)
+	{
+		if (data_read_ >= format_.data_size)
+		{
+			if (!looping_)
+				return frames_read > 0;
+
+			fseek(file_, format_.data_offset, SEEK_SET);
+			data_read_ = 0;
+		}
+
+		UInt32 want = (frame_count - frames_read) * bytes_per_frame;
+		if (want > format_.data_size - data_read_)
+			want = format_.data_size - data_read_;
+
+		const UInt32 got = (UInt32)fread(&file_chunk_[0], 1, want, file_) / bytes_per_frame * bytes_per_frame;
+		if (got == 0)
+			return frames_read > 0;
+		data_read_ += got;
+
+		const UInt32 got_frames = got / bytes_per_frame;
+		Int16* out = frames + frames_read * 2;
+		DecodePCM(&file_chunk_[0], got_frames * format_.channels, format_.bits_per_sample, out);
+
+		// mono goes out on both sides, spread in place from the back
+		if (format_.channels == 1)
+		{
+			for (UInt32 frame = got_frames; frame-- > 0;)
+			{
+				out[frame * 2 + 1] = out[frame];
+				out[frame * 2] = out[frame];
+			}
+		}
+
+		frames_read += got_frames;
+	}
+
+	return true;
+}
+
+void MusicStream::Run()
+{
+	MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+	std::vector<Int16> chunk(kChunkFrames * 2);
+
+	while (!stopping_)
+	{
+		// wait for a chunk's worth of room. the mixer doesn't take the lock, so this
+		// wakes up now and then in case its notify came before the wait
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			space_ready_.wait_for(lock, std::chrono::milliseconds(10), [this]
+			{
+				return stopping_ || kRingFrames - (write_frame_.load() - read_frame_.load()) >= kChunkFrames;
+			});
+		}
+
+		if (stopping_)
+			break;
+
+		if (kRingFrames - (write_frame_.load() - read_frame_.load()) < kChunkFrames)
+			continue;
+
+		UInt32 frames_read = 0;
+		const bool more = ReadChunk(&chunk[0], kChunkFrames, frames_read);
+
+		const UInt32 write_frame = write_frame_.load(std::memory_order_relaxed);
+		for (UInt32 frame = 0; frame < frames_read; ++frame)
+		{
+			Int16* ring_frame = &ring_[((write_frame + frame) % kRingFrames) * 2];
+			ring_frame[0] = chunk[frame * 2];
+			ring_frame[1] = chunk[frame * 2 + 1];
+		}
+		write_frame_.store(write_frame + frames_read, std::memory_order_release);
+
+		if (!more)
+		{
+			finished_ = true;
+			break;
+		}
+	}
+}
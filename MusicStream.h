@@ -0,0 +1,64 @@
+#ifndef _MUSIC_STREAM_H
+#define _MUSIC_STREAM_H
+
+#include "WavFile.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// plays a wav from disk a chunk at a time rather than loading it whole. a reader
+// thread keeps a small ring of decoded stereo frames topped up and the mixer
+// drains it, with no lock between them
+class MusicStream
+{
+public:
+	static const UInt32 kChunkFrames = 4096;
+	static const UInt32 kNumChunks = 4;
+
+	MusicStream();
+	~MusicStream();
+
+	bool Open(const char* filename, bool looping);
+	void Close();
+
+	// adds up to frame_count stereo frames of music at output_rate into out, resampled
+	// if the wav is at another rate, returns how many were ready. anything the reader
+	// hasn't got to yet is left silent and counted
+	UInt32 Mix(float* out, UInt32 frame_count, UInt32 output_rate, float volume);
+
+	inline bool is_open() const { return thread_.joinable(); }
+	inline UInt32 sample_rate() const { return format_.sample_rate; }
+	inline UInt32 underruns() const { return underruns_; }
+	inline size_t buffer_bytes() const { return ring_.size() * sizeof(Int16); }
+
+private:
+	void Run();
+
+	// reads and decodes up to frame_count frames as stereo, false at the end of a one shot
+	bool ReadChunk(Int16* frames, UInt32 frame_count, UInt32& frames_read);
+
+	FILE* file_;
+	WavFormat format_;
+	UInt32 data_read_;
+	bool looping_;
+	std::vector<UInt8> file_chunk_;
+
+	// interleaved stereo, frame counts only ever go up and wrap by the ring size
+	std::vector<Int16> ring_;
+	std::atomic<UInt32> write_frame_;
+	std::atomic<UInt32> read_frame_;
+	std::atomic<bool> finished_;
+	UInt32 underruns_;
+
+	// how far past read_frame_ the resampler is, only the mixer touches it
+	double fraction_;
+
+	std::thread thread_;
+	std::mutex mutex_;
+	std::condition_variable space_ready_;
+	std::atomic<bool> stopping_;
+};
+
+#endif // _MUSIC_STREAM_H
@@ -0,0 +1,243 @@
+#include "ProjectileSystem.h"
+#include "JobSystem.h"
+#include "ArenaBounds.h"
+#include "RenderPacket.h"
+#include <input/input_manager.h>
+#include <input/keyboard.h>
+#include <graphics/renderer_3d.h>
+
+static const float kBulletSpeed = 30.0f;
+static const float kBulletLifetime = 2.0f;
+static const float kFireInterval = 0.15f;
+static const float kBulletScale = 0.5f;
+
+// most shots one CreateNew call can fire, only a hitch longer than this many intervals hits it
+static const int kMaxShotsPerCall = 4;
+
+// bullets per ray cast job
+static const int kRayCastGrain = 512;
+
+// keeps the closest enemy or wall along the ray, everything else is ignored
+class ClosestTargetCallback : public b2RayCastCallback
+{
+public:
+	ClosestTargetCallback() :
+		object(NULL),
+		point(0.0f, 0.0f)
+	{
+	}
+
+	float ReportFixture(b2Fixture* fixture, const b2Vec2& hit_point, const b2Vec2& normal, float fraction)
+	{
+		GameObject* game_object = reinterpret_cast<GameObject*>(fixture->GetBody()->GetUserData().pointer);
+		if (!game_object || (game_object->type() != ENEMY && game_object->type() != WALL))
+			return -1.0f;
+
+		object = game_object;
+		point = hit_point;
+
+		// clip the ray here so only closer hits get reported from now on
+		return fraction;
+	}
+
+	GameObject* object;
+	b2Vec2 point;
+};
+
+ProjectileSystem::ProjectileSystem() :
+	live_count_(0),
+	cooldown_(0.0f)
+{
+}
+
+void ProjectileSystem::Init(int capacity, const gef::Mesh* mesh)
+{
+	position_x_.resize(capacity);
+	position_y_.resize(capacity);
+	velocity_x_.resize(capacity);
+	velocity_y_.resize(capacity);
+	life_.resize(capacity);
+	delay_.resize(capacity);
+	hit_objects_.resize(capacity);
+	hit_points_.resize(capacity);
+	hits_.reserve(capacity);
+	outside_.resize(capacity);
+
+	mesh_instance_.set_mesh(mesh);
+
+	Clear();
+}
+
+void ProjectileSystem::Clear()
+{
+	live_count_ = 0;
+	cooldown_ = 0.0f;
+	hits_.clear();
+}
+
+void ProjectileSystem::CreateNew(gef::InputManager* input_manager, const b2Vec2& position, float frame_time)
+{
+	b2Vec2 direction(0.0f, 0.0f);
+	const gef::Keyboard* keyboard = input_manager->keyboard();
+	if (keyboard)
+	{
+		if (keyboard->IsKeyDown(gef::Keyboard::KC_UP))
+			direction.y += 1.0f;
+		if (keyboard->IsKeyDown(gef::Keyboard::KC_DOWN))
+			direction.y -= 1.0f;
+		if (keyboard->IsKeyDown(gef::Keyboard::KC_LEFT))
+			direction.x -= 1.0f;
+		if (keyboard->IsKeyDown(gef::Keyboard::KC_RIGHT))
+			direction.x += 1.0f;
+	}
+
+	// not firing, the cooldown runs out but doesn't bank shots for when the key goes down
+	if (direction.Normalize() == 0.0f)
+	{
+		cooldown_ -= frame_time;
+		if (cooldown_ < 0.0f)
+			cooldown_ = 0.0f;
+		return;
+	}
+
+	// cooldown_ is how far into this call's time the next shot is due. every shot due
+	// before the end goes out, late by however long it was due before the end, and the
+	// interval is added on rather than reset so the leftover carries to the next call
+	int shots = 0;
+	while (cooldown_ < frame_time)
+	{
+		if (shots == kMaxShotsPerCall)
+		{
+			// a long hitch, drop the rest rather than firing a wall of bullets
+			cooldown_ = frame_time;
+			break;
+		}
+
+		// a full pool loses the shot but keeps the schedule
+		Fire(position, direction, cooldown_);
+		cooldown_ += kFireInterval;
+		shots++;
+	}
+
+	cooldown_ -= frame_time;
+}
+
+bool ProjectileSystem::Fire(const b2Vec2& position, const b2Vec2& direction, float delay)
+{
+	if (live_count_ == (int)life_.size())
+		return false;
+
+	const int index = live_count_++;
+	position_x_[index] = position.x;
+	position_y_[index] = position.y;
+	velocity_x_[index] = direction.x * kBulletSpeed;
+	velocity_y_[index] = direction.y * kBulletSpeed;
+	life_[index] = kBulletLifetime;
+	delay_[index] = delay;
+
+	return true;
+}
+
+void ProjectileSystem::Remove(int index)
+{
+	// swap the last live bullet into the gap
+	const int last = --live_count_;
+	position_x_[index] = position_x_[last];
+	position_y_[index] = position_y_[last];
+	velocity_x_[index] = velocity_x_[last];
+	velocity_y_[index] = velocity_y_[last];
+	life_[index] = life_[last];
+	delay_[index] = delay_[last];
+	hit_objects_[index] = hit_objects_[last];
+	hit_points_[index] = hit_points_[last];
+}
+
+void ProjectileSystem::Update(float frame_time, const b2World* world, JobSystem* job_system)
+{
+	hits_.clear();
+
+	// the world is only read here, so the casts can run in parallel
+	job_system->ParallelFor(live_count_, kRayCastGrain, [this, frame_time, world](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			// a bullet fired part way through the step only covers the rest of it
+			const float move_time = frame_time - delay_[i];
+			delay_[i] = 0.0f;
+
+			const b2Vec2 start(position_x_[i], position_y_[i]);
+			const b2Vec2 finish(start.x + velocity_x_[i] * move_time, start.y + velocity_y_[i] * move_time);
+
+			ClosestTargetCallback callback;
+			world->RayCast(&callback, start, finish);
+
+			hit_objects_[i] = callback.object;
+			hit_points_[i] = callback.point;
+
+			position_x_[i] = finish.x;
+			position_y_[i] = finish.y;
+			life_[i] -= move_time;
+		}
+	});
+
+	// collect the hits and retire spent bullets, backwards so swapped in bullets are already processed
+	for (int i = live_count_ - 1; i >= 0; --i)
+	{
+		if (hit_objects_[i])
+		{
+			ProjectileHit hit;
+			hit.object = hit_objects_[i];
+			hit.point = hit_points_[i];
+			hits_.push_back(hit);
+			Remove(i);
+		}
+		else if (life_[i] <= 0.0f)
+		{
+			Remove(i);
+		}
+	}
+}
+
+int ProjectileSystem::RetireOutside(const ArenaBounds& bounds)
+{
+	if (live_count_ == 0)
+		return 0;
+
+	const int num_outside = bounds.TestOutside(&position_x_[0], &position_y_[0], live_count_, &outside_[0]);
+	if (num_outside == 0)
+		return 0;
+
+	for (int i = live_count_ - 1; i >= 0; --i)
+	{
+		if (outside_[i])
+			Remove(i);
+	}
+
+	return num_outside;
+}
+
+void ProjectileSystem::Render(gef::Renderer3D* renderer_3d)
+{
+	gef::Matrix44 transform;
+	transform.Scale(gef::Vector4(kBulletScale, kBulletScale, kBulletScale));
+
+	for (int i = 0; i < live_count_; ++i)
+	{
+		transform.SetTranslation(gef::Vector4(position_x_[i], position_y_[i], 0.0f));
+		mesh_instance_.set_transform(transform);
+		renderer_3d->DrawMesh(mesh_instance_);
+	}
+}
+
+void ProjectileSystem::AddToPacket(RenderPacket& packet, UInt32 colour)
+{
+	gef::Matrix44 transform;
+	transform.Scale(gef::Vector4(kBulletScale, kBulletScale, kBulletScale));
+
+	for (int i = 0; i < live_count_; ++i)
+	{
+		transform.SetTranslation(gef::Vector4(position_x_[i], position_y_[i], 0.0f));
+		mesh_instance_.set_transform(transform);
+		packet.AddMesh(mesh_instance_, colour);
+	}
+}
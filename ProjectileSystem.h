@@ -0,0 +1,83 @@
+#ifndef _PROJECTILE_SYSTEM_H
+#define _PROJECTILE_SYSTEM_H
+
+#include <box2d/Box2D.h>
+#include <graphics/mesh_instance.h>
+#include <vector>
+#include "game_object.h"
+
+namespace gef
+{
+	class InputManager;
+	class Mesh;
+	class Renderer3D;
+}
+
+class JobSystem;
+class ArenaBounds;
+struct RenderPacket;
+
+struct ProjectileHit
+{
+	GameObject* object;
+	b2Vec2 point;
+};
+
+// bullets without rigid bodies, each one is moved as a line segment and ray cast
+// against the world for the first enemy or wall it crosses, so none of them go
+// through the broadphase, contacts or solver
+class ProjectileSystem
+{
+public:
+	ProjectileSystem();
+
+	void Init(int capacity, const gef::Mesh* mesh);
+	void Clear();
+
+	// same controls as BulletManager, arrow keys fire in that direction. shots are
+	// scheduled on their own clock rather than once per call, so a long frame_time
+	// fires every shot that fell due in it, each at the time it was due
+	void CreateNew(gef::InputManager* input_manager, const b2Vec2& position, float frame_time);
+
+	// delay is how far into the next Update the bullet was fired, it only moves for
+	// the rest of that step
+	bool Fire(const b2Vec2& position, const b2Vec2& direction, float delay = 0.0f);
+
+	// moves every bullet and collects what they hit, the ray casts run across the job threads
+	void Update(float frame_time, const b2World* world, JobSystem* job_system);
+
+	// drops every bullet that has left the arena, returns how many went
+	int RetireOutside(const ArenaBounds& bounds);
+
+	void Render(gef::Renderer3D* renderer_3d);
+	void AddToPacket(RenderPacket& packet, UInt32 colour);
+
+	// what was hit during the last Update, those bullets are already gone
+	inline const std::vector<ProjectileHit>& hits() const { return hits_; }
+	inline int live_count() const { return live_count_; }
+
+private:
+	void Remove(int index);
+
+	// struct of arrays so the per bullet loops stay tight
+	std::vector<float> position_x_;
+	std::vector<float> position_y_;
+	std::vector<float> velocity_x_;
+	std::vector<float> velocity_y_;
+	std::vector<float> life_;
+	std::vector<float> delay_;
+
+	// filled in by the ray cast jobs, one per bullet
+	std::vector<GameObject*> hit_objects_;
+	std::vector<b2Vec2> hit_points_;
+
+	std::vector<ProjectileHit> hits_;
+	std::vector<UInt8> outside_;
+
+	int live_count_;
+	float cooldown_;
+
+	gef::MeshInstance mesh_instance_;
+};
+
+#endif // _PROJECTILE_SYSTEM_H
@@ -0,0 +1,72 @@
+#include "Random.h"
+
+static inline UInt32 RotateLeft(UInt32 x, int k)
+{
+	return (x << k) | (x >> (32 - k));
+}
+
+// splitmix32, spreads a single seed across the four words of state
+static UInt32 SplitMix(UInt32& x)
+{
+	UInt32 z = (x += 0x9e3779b9u);
+	z = (z ^ (z >> 16)) * 0x85ebca6bu;
+	z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+	return z ^ (z >> 16);
+}
+
+Random::Random()
+{
+	Seed(0);
+}
+
+Random::Random(UInt32 seed, UInt32 stream)
+{
+	Seed(seed, stream);
+}
+
+void Random::Seed(UInt32 seed, UInt32 stream)
+{
+	UInt32 x = seed ^ (stream * 0x632be5abu);
+	for (int i = 0; i < 4; ++i)
+		state_.s[i] = SplitMix(x);
+}
+
+UInt32 Random::NextUInt32()
+{
+	UInt32* s = state_.s;
+	const UInt32 result = RotateLeft(s[1] * 5, 7) * 9;
+	const UInt32 t = s[1] << 9;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = RotateLeft(s[3], 11);
+
+	return result;
+}
+
+float Random::NextFloat()
+{
+	// top 24 bits fill the float mantissa exactly
+	return (NextUInt32() >> 8) * (1.0f / 16777216.0f);
+}
+
+float Random::Range(float min, float max)
+{
+	return min + (max - min) * NextFloat();
+}
+
+int Random::RangeInt(int min, int max)
+{
+	UInt32 range = (UInt32)(max - min) + 1;
+	return min + (int)(((UInt64)NextUInt32() * range) >> 32);
+}
+
+void Random::Fill(float* out, int count, float min, float max)
+{
+	const float scale = (max - min) * (1.0f / 16777216.0f);
+	for (int i = 0; i < count; ++i)
+		out[i] = min + (NextUInt32() >> 8) * scale;
+}
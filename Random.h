@@ -0,0 +1,51 @@
+#ifndef _RANDOM_H
+#define _RANDOM_H
+
+#include <gef.h>
+
+// one stream per subsystem, so adding draws in one never shifts another
+enum RandomStream
+{
+	RNG_ENEMY_SPAWN = 1,
+	// reseeds rand() every step, for the managers that still draw from it
+	RNG_STEP_RAND = 2
+};
+
+// small xoshiro128** generator, one per subsystem so they can be seeded
+// separately and never touch the shared rand() state
+class Random
+{
+public:
+	struct State
+	{
+		UInt32 s[4];
+	};
+
+	Random();
+	explicit Random(UInt32 seed, UInt32 stream = 0);
+
+	// the stream number gives each subsystem its own sequence from the same seed
+	void Seed(UInt32 seed, UInt32 stream = 0);
+
+	UInt32 NextUInt32();
+
+	// [0, 1)
+	float NextFloat();
+
+	// [min, max)
+	float Range(float min, float max);
+
+	// [min, max]
+	int RangeInt(int min, int max);
+
+	// fills count floats in [min, max) in one go
+	void Fill(float* out, int count, float min, float max);
+
+	inline const State& state() const { return state_; }
+	inline void set_state(const State& state) { state_ = state; }
+
+private:
+	State state_;
+};
+
+#endif // _RANDOM_H
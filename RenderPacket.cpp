@@ -0,0 +1,114 @@
+#include "RenderPacket.h"
+#include <graphics/mesh_instance.h>
+#include <graphics/mesh.h>
+#include <maths/aabb.h>
+
+//
+// RenderPacket
+//
+void RenderPacket::Clear()
+{
+	// clear keeps the capacity, so a reused packet stops allocating once it has seen a busy frame
+	objects.clear();
+	quads.clear();
+}
+
+void RenderPacket::AddMesh(const gef::MeshInstance& mesh_instance, UInt32 colour)
+{
+	const gef::Mesh* mesh = mesh_instance.mesh();
+	if (!mesh)
+		return;
+
+	RenderObject object;
+	object.transform = mesh_instance.transform();
+	object.min = mesh->aabb().min_vtx();
+	object.max = mesh->aabb().max_vtx();
+	object.colour = colour;
+	objects.push_back(object);
+}
+
+void RenderPacket::AddQuad(float x, float y, float width, float height, UInt32 colour)
+{
+	RenderQuad quad;
+	quad.x = x;
+	quad.y = y;
+	quad.width = width;
+	quad.height = height;
+	quad.colour = colour;
+	quads.push_back(quad);
+}
+
+//
+// RenderPacketQueue
+//
+RenderPacketQueue::RenderPacketQueue() :
+	write_index_(0),
+	read_index_(0),
+	ready_count_(0),
+	writing_(false),
+	reading_(false),
+	stopped_(false)
+{
+}
+
+RenderPacket* RenderPacketQueue::BeginWrite()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	// the packet being read counts as taken too
+	changed_.wait(lock, [this] { return ready_count_ + (reading_ ? 1 : 0) < kNumPackets; });
+
+	writing_ = true;
+	RenderPacket* packet = &packets_[write_index_];
+	packet->Clear();
+	return packet;
+}
+
+void RenderPacketQueue::EndWrite()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		write_index_ = (write_index_ + 1) % kNumPackets;
+		ready_count_++;
+		writing_ = false;
+	}
+	changed_.notify_all();
+}
+
+const RenderPacket* RenderPacketQueue::BeginRead()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	changed_.wait(lock, [this] { return ready_count_ > 0 || stopped_; });
+
+	if (ready_count_ == 0)
+		return NULL;
+
+	reading_ = true;
+	ready_count_--;
+	return &packets_[read_index_];
+}
+
+void RenderPacketQueue::EndRead()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		read_index_ = (read_index_ + 1) % kNumPackets;
+		reading_ = false;
+	}
+	changed_.notify_all();
+}
+
+void RenderPacketQueue::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopped_ = true;
+	}
+	changed_.notify_all();
+}
+
+void RenderPacketQueue::Flush()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	changed_.wait(lock, [this] { return (ready_count_ == 0 && !reading_) || stopped_; });
+}
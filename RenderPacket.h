@@ -0,0 +1,94 @@
+#ifndef _RENDER_PACKET_H
+#define _RENDER_PACKET_H
+
+#include <gef.h>
+#include <maths/matrix44.h>
+#include <maths/vector4.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace gef
+{
+	class MeshInstance;
+}
+
+struct RenderObject
+{
+	gef::Matrix44 transform;
+	gef::Vector4 min;
+	gef::Vector4 max;
+	UInt32 colour;
+};
+
+struct RenderQuad
+{
+	float x, y;
+	float width, height;
+	UInt32 colour;
+};
+
+// everything a frame needs drawn, copied out of the simulation so the render
+// thread never touches live game state
+struct RenderPacket
+{
+	UInt32 frame;
+	UInt32 clear_colour;
+
+	gef::Matrix44 projection_matrix;
+	gef::Matrix44 view_matrix;
+
+	// drawn in order, objects first then quads over the top
+	std::vector<RenderObject> objects;
+	std::vector<RenderQuad> quads;
+
+	// HUD values as they were when the packet was made
+	float fps;
+	int touching_count;
+	int contact_count;
+	float step_time_ms;
+
+	void Clear();
+	void AddMesh(const gef::MeshInstance& mesh_instance, UInt32 colour);
+	void AddQuad(float x, float y, float width, float height, UInt32 colour);
+};
+
+// a fixed ring of packets between the simulation and the render thread. the
+// simulation fills one while the render thread draws another, and only waits
+// if it gets kNumPackets - 1 frames ahead.
+class RenderPacketQueue
+{
+public:
+	// two being worked on and one spare, so neither side waits on a handover
+	static const int kNumPackets = 3;
+
+	RenderPacketQueue();
+
+	// waits for a free packet, which comes back cleared
+	RenderPacket* BeginWrite();
+	void EndWrite();
+
+	// waits for a finished packet, NULL once Stop has been called and everything is drawn
+	const RenderPacket* BeginRead();
+	void EndRead();
+
+	// wakes the reader so it can finish
+	void Stop();
+
+	// blocks until the render thread has drawn everything written so far
+	void Flush();
+
+private:
+	RenderPacket packets_[kNumPackets];
+
+	std::mutex mutex_;
+	std::condition_variable changed_;
+	int write_index_;
+	int read_index_;
+	int ready_count_;
+	bool writing_;
+	bool reading_;
+	bool stopped_;
+};
+
+#endif // _RENDER_PACKET_H
@@ -0,0 +1,65 @@
+#include "RenderThread.h"
+#include "SoftwareRenderer.h"
+
+RenderThread::RenderThread(SoftwareRenderer* renderer, RenderPacketQueue* queue) :
+	renderer_(renderer),
+	queue_(queue),
+	frames_drawn_(0),
+	raster_time_ms_(0.0f),
+	triangle_count_(0)
+{
+}
+
+RenderThread::~RenderThread()
+{
+	Stop();
+}
+
+void RenderThread::Start()
+{
+	if (!thread_.joinable())
+		thread_ = std::thread(&RenderThread::Run, this);
+}
+
+void RenderThread::Stop()
+{
+	if (!thread_.joinable())
+		return;
+
+	queue_->Stop();
+	thread_.join();
+}
+
+void RenderThread::Draw(SoftwareRenderer* renderer, const RenderPacket& packet)
+{
+	renderer->set_projection_matrix(packet.projection_matrix);
+	renderer->set_view_matrix(packet.view_matrix);
+	renderer->Begin(packet.clear_colour);
+
+	for (size_t i = 0; i < packet.objects.size(); ++i)
+	{
+		const RenderObject& object = packet.objects[i];
+		renderer->DrawBox(object.transform, object.min, object.max, object.colour);
+	}
+
+	for (size_t i = 0; i < packet.quads.size(); ++i)
+	{
+		const RenderQuad& quad = packet.quads[i];
+		renderer->DrawQuad(quad.x, quad.y, quad.width, quad.height, quad.colour);
+	}
+
+	renderer->End();
+}
+
+void RenderThread::Run()
+{
+	while (const RenderPacket* packet = queue_->BeginRead())
+	{
+		Draw(renderer_, *packet);
+		queue_->EndRead();
+
+		raster_time_ms_ = renderer_->raster_time_ms();
+		triangle_count_ = renderer_->triangle_count();
+		frames_drawn_++;
+	}
+}
@@ -0,0 +1,43 @@
+#ifndef _RENDER_THREAD_H
+#define _RENDER_THREAD_H
+
+#include "RenderPacket.h"
+#include <atomic>
+#include <thread>
+
+class SoftwareRenderer;
+
+// draws packets from a RenderPacketQueue on its own thread, so the next frame's
+// update overlaps this one's rasterisation
+class RenderThread
+{
+public:
+	RenderThread(SoftwareRenderer* renderer, RenderPacketQueue* queue);
+	~RenderThread();
+
+	void Start();
+
+	// draws whatever is still queued, then joins
+	void Stop();
+
+	// draws a packet on the calling thread, what the render thread does for each one
+	static void Draw(SoftwareRenderer* renderer, const RenderPacket& packet);
+
+	// safe to read from any thread
+	inline UInt32 frames_drawn() const { return frames_drawn_.load(); }
+	inline float raster_time_ms() const { return raster_time_ms_.load(); }
+	inline int triangle_count() const { return triangle_count_.load(); }
+
+private:
+	void Run();
+
+	SoftwareRenderer* renderer_;
+	RenderPacketQueue* queue_;
+	std::thread thread_;
+
+	std::atomic<UInt32> frames_drawn_;
+	std::atomic<float> raster_time_ms_;
+	std::atomic<int> triangle_count_;
+};
+
+#endif // _RENDER_THREAD_H
@@ -0,0 +1,119 @@
+#include "SampleBank.h"
+#include "MemoryTracker.h"
+#include "WavFile.h"
+#include "ImaAdpcm.h"
+#include <system/debug_log.h>
+#include <cstdio>
+
+SampleBank::SampleBank()
+{
+}
+
+int SampleBank::LoadWav(const char* filename, const SampleLimits& limits)
+{
+	MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+	FILE* file = fopen(filename, "rb");
+	if (!file)
+	{
+		gef::DebugOut("Could not open %s\n", filename);
+		return -1;
+	}
+
+	WavFormat format;
+	if (!ReadWavHeader(file, format))
+	{
+		gef::DebugOut("%s: only 8 or 16 bit PCM wav, mono or stereo\n", filename);
+		fclose(file);
+		return -1;
+	}
+
+	std::vector<UInt8> data(format.data_size);
+	if (format.data_size > 0)
+		data.resize(fread(&data[0], 1, format.data_size, file));
+	fclose(file);
+
+	const UInt32 frame_count = (UInt32)data.size() / format.bytes_per_frame();
+
+	std::vector<Int16> frames(frame_count * format.channels);
+	if (!frames.empty())
+		DecodePCM(&data[0], (UInt32)frames.size(), format.bits_per_sample, &frames[0]);
+
+	return AddSample(filename, frames.empty() ? NULL : &frames[0], frame_count, format.channels, format.sample_rate, limits);
+}
+
+int SampleBank::LoadAdpcm(const char* filename, const SampleLimits& limits)
+{
+	MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+	AdpcmHeader header;
+	std::vector<UInt8> data;
+	if (!ReadAdpcmFile(filename, header, data))
+	{
+		gef::DebugOut("Could not load %s\n", filename);
+		return -1;
+	}
+
+	SampleInfo info;
+	info.filename = filename;
+	info.offset = (UInt32)data_.size();
+	info.frame_count = header.frame_count;
+	info.sample_rate = header.sample_rate;
+	info.channels = header.channels;
+	info.limits = limits;
+	info.has_frames = true;
+
+	// straight into the bank, there's no PCM copy of the file to throw away
+	data_.resize(data_.size() + header.frame_count * header.channels);
+	if (header.frame_count > 0)
+		DecodeAdpcm(&data[0], header.frame_count, header.channels, header.block_frames, &data_[info.offset]);
+
+	samples_.push_back(info);
+
+	return (int)samples_.size() - 1;
+}
+
+int SampleBank::AddHeader(const char* name, UInt32 frame_count, UInt16 channels, UInt32 sample_rate, const SampleLimits& limits)
+{
+	MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+	SampleInfo info;
+	info.filename = name;
+	info.offset = (UInt32)data_.size();
+	info.frame_count = frame_count;
+	info.sample_rate = sample_rate;
+	info.channels = channels;
+	info.limits = limits;
+	info.has_frames = false;
+
+	samples_.push_back(info);
+
+	return (int)samples_.size() - 1;
+}
+
+int SampleBank::AddSample(const char* name, const Int16* frames, UInt32 frame_count, UInt16 channels, UInt32 sample_rate, const SampleLimits& limits)
+{
+	MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+	SampleInfo info;
+	info.filename = name;
+	info.offset = (UInt32)data_.size();
+	info.frame_count = frame_count;
+	info.sample_rate = sample_rate;
+	info.channels = channels;
+	info.limits = limits;
+	info.has_frames = true;
+
+	data_.insert(data_.end(), frames, frames + frame_count * channels);
+	samples_.push_back(info);
+
+	return (int)samples_.size() - 1;
+}
+
+void SampleBank::Clear()
+{
+	samples_.clear();
+
+	std::vector<Int16> empty;
+	data_.swap(empty);
+}
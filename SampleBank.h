@@ -0,0 +1,65 @@
+#ifndef _SAMPLE_BANK_H
+#define _SAMPLE_BANK_H
+
+#include <gef.h>
+#include <string>
+#include <vector>
+
+// how much of the voice pool one sample may take. a shot that hits twenty enemies in a
+// step still only starts max_voices of it, and not again until cooldown has passed
+struct SampleLimits
+{
+	int max_voices;
+	float cooldown;
+
+	// when the pool is full, a new sound takes over the oldest voice at or below its priority
+	int priority;
+};
+
+struct SampleInfo
+{
+	std::string filename;
+	UInt32 offset;
+	UInt32 frame_count;
+	UInt32 sample_rate;
+	UInt16 channels;
+	SampleLimits limits;
+
+	// false for header only samples, frames() has nothing for them
+	bool has_frames;
+
+	inline float duration() const { return sample_rate > 0 ? (float)frame_count / (float)sample_rate : 0.0f; }
+};
+
+// every sound effect decoded to 16 bit PCM once, at load, into one buffer
+class SampleBank
+{
+public:
+	SampleBank();
+
+	// PCM wav files, 8 or 16 bit, mono or stereo. returns the sample id or -1
+	int LoadWav(const char* filename, const SampleLimits& limits);
+
+	// IMA ADPCM .adp files from tools/adpcm_convert, decoded into the bank as they load
+	int LoadAdpcm(const char* filename, const SampleLimits& limits);
+
+	// just the length, rate and limits, for an output that plays its own copy of the
+	// sound (OpenAL through gef) and only needs the pool to time the voices
+	int AddHeader(const char* name, UInt32 frame_count, UInt16 channels, UInt32 sample_rate, const SampleLimits& limits);
+
+	// already decoded frames, interleaved if there's more than one channel
+	int AddSample(const char* name, const Int16* frames, UInt32 frame_count, UInt16 channels, UInt32 sample_rate, const SampleLimits& limits);
+
+	void Clear();
+
+	inline int sample_count() const { return (int)samples_.size(); }
+	inline const SampleInfo& sample(int sample_id) const { return samples_[sample_id]; }
+	inline const Int16* frames(int sample_id) const { return data_.data() + samples_[sample_id].offset; }
+	inline size_t data_bytes() const { return data_.size() * sizeof(Int16); }
+
+private:
+	std::vector<SampleInfo> samples_;
+	std::vector<Int16> data_;
+};
+
+#endif // _SAMPLE_BANK_H
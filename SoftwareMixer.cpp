@@ -0,0 +1,263 @@
+#include "SoftwareMixer.h"
+#include "SampleBank.h"
+#include "MusicStream.h"
+#include "MemoryTracker.h"
+#include "WavFile.h"
+#include <chrono>
+#include <math.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SOFTWARE_MIXER_SSE
+#endif
+
+// a long hitch would otherwise come out as one enormous mix
+static const UInt32 kMaxMixFrames = SoftwareMixer::kOutputRate / 4;
+
+NullAudioSink::NullAudioSink() :
+	frames_written_(0)
+{
+}
+
+void NullAudioSink::Write(const float*, UInt32 frame_count)
+{
+	frames_written_ += frame_count;
+}
+
+WavFileSink::WavFileSink() :
+	file_(NULL),
+	sample_rate_(0),
+	data_size_(0)
+{
+}
+
+WavFileSink::~WavFileSink()
+{
+	Close();
+}
+
+bool WavFileSink::Open(const char* filename, UInt32 sample_rate)
+{
+	Close();
+
+	file_ = fopen(filename, "wb");
+	if (!file_)
+		return false;
+
+	sample_rate_ = sample_rate;
+	data_size_ = 0;
+	WriteWavHeader(file_, 2, sample_rate_, 0);
+	return true;
+}
+
+void WavFileSink::Close()
+{
+	if (!file_)
+		return;
+
+	// now the length is known
+	fseek(file_, 0, SEEK_SET);
+	WriteWavHeader(file_, 2, sample_rate_, data_size_);
+	fclose(file_);
+	file_ = NULL;
+}
+
+void WavFileSink::Write(const float* frames, UInt32 frame_count)
+{
+	if (!file_)
+		return;
+
+	buffer_.resize(frame_count * 2);
+	for (UInt32 sample_num = 0; sample_num < frame_count * 2; ++sample_num)
+		buffer_[sample_num] = (Int16)(frames[sample_num] * 32767.0f);
+
+	fwrite(buffer_.data(), sizeof(Int16), buffer_.size(), file_);
+	data_size_ += frame_count * 2 * sizeof(Int16);
+}
+
+SoftwareMixer::SoftwareMixer() :
+	bank_(NULL),
+	sink_(NULL),
+	music_(NULL),
+	music_volume_(1.0f),
+	frame_carry_(0.0),
+	mix_time_ms_(0.0f),
+	frames_mixed_(0),
+	voice_time_us_(0.0),
+	voice_frames_mixed_(0.0)
+{
+	for (int voice_num = 0; voice_num < VoicePool::kMaxVoices; ++voice_num)
+		voices_[voice_num].active = false;
+}
+
+void SoftwareMixer::Init(const SampleBank* bank, AudioSink* sink)
+{
+	MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+	bank_ = bank;
+	sink_ = sink;
+	frame_carry_ = 0.0;
+
+	for (int voice_num = 0; voice_num < VoicePool::kMaxVoices; ++voice_num)
+		voices_[voice_num].active = false;
+
+	// the largest mix there can be, so the buffer never grows during play
+	mix_buffer_.reserve(kMaxMixFrames * 2);
+}
+
+void SoftwareMixer::StartVoice(int voice_num, const Voice& voice)
+{
+	const SampleInfo& info = bank_->sample(voice.sample);
+
+	// pan -1 is hard left, 1 hard right. the far side fades out, the near one stays at volume
+	MixerVoice& mixer_voice = voices_[voice_num];
+	mixer_voice.sample = voice.sample;
+	mixer_voice.cursor = 0.0;
+	mixer_voice.step = (double)info.sample_rate / (double)kOutputRate;
+	mixer_voice.left_gain = voice.volume * (voice.pan > 0.0f ? 1.0f - voice.pan : 1.0f);
+	mixer_voice.right_gain = voice.volume * (voice.pan < 0.0f ? 1.0f + voice.pan : 1.0f);
+	mixer_voice.active = info.frame_count > 1 && info.sample_rate > 0;
+}
+
+void SoftwareMixer::StopVoice(int voice_num)
+{
+	voices_[voice_num].active = false;
+}
+
+void SoftwareMixer::Mix(const Voice*, int, float frame_time)
+{
+	typedef std::chrono::high_resolution_clock Clock;
+	const Clock::time_point mix_start = Clock::now();
+
+	const double frames_wanted = frame_time * (double)kOutputRate + frame_carry_;
+	UInt32 frame_count = (UInt32)frames_wanted;
+	frame_carry_ = frames_wanted - frame_count;
+	if (frame_count > kMaxMixFrames)
+	{
+		frame_count = kMaxMixFrames;
+		frame_carry_ = 0.0;
+	}
+
+	if (frame_count == 0 || !sink_)
+		return;
+
+	mix_buffer_.assign(frame_count * 2, 0.0f);
+	float* out = &mix_buffer_[0];
+
+	if (music_)
+		music_->Mix(out, frame_count, kOutputRate, music_volume_);
+
+	const Clock::time_point voice_start = Clock::now();
+	int voices_mixed = 0;
+	for (int voice_num = 0; voice_num < VoicePool::kMaxVoices; ++voice_num)
+	{
+		MixerVoice& voice = voices_[voice_num];
+		if (!voice.active)
+			continue;
+
+		if (!MixVoice(voice, out, frame_count))
+			voice.active = false;
+		voices_mixed++;
+	}
+	voice_time_us_ += std::chrono::duration<double, std::micro>(Clock::now() - voice_start).count();
+	voice_frames_mixed_ += (double)voices_mixed * frame_count;
+
+	// clip rather than wrap when enough is playing to go over
+	UInt32 sample_num = 0;
+#ifdef SOFTWARE_MIXER_SSE
+	const __m128 low = _mm_set1_ps(-1.0f);
+	const __m128 high = _mm_set1_ps(1.0f);
+	for (; sample_num + 4 <= frame_count * 2; sample_num += 4)
+		_mm_storeu_ps(out + sample_num, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + sample_num), low), high));
+#endif
+	for (; sample_num < frame_count * 2; ++sample_num)
+		out[sample_num] = out[sample_num] < -1.0f ? -1.0f : (out[sample_num] > 1.0f ? 1.0f : out[sample_num]);
+
+	sink_->Write(out, frame_count);
+
+	frames_mixed_ += frame_count;
+	mix_time_ms_ = std::chrono::duration<float, std::milli>(Clock::now() - mix_start).count();
+}
+
+bool SoftwareMixer::MixVoice(MixerVoice& voice, float* out, UInt32 frame_count)
+{
+	const SampleInfo& info = bank_->sample(voice.sample);
+	const Int16* frames = bank_->frames(voice.sample);
+	const UInt32 channels = info.channels;
+	const UInt32 right_offset = channels == 2 ? 1 : 0;
+
+	// every output frame reads the source frame before and after it, so stop short of the last
+	const double last = (double)info.frame_count - 1.0;
+	if (voice.cursor >= last)
+		return false;
+
+	UInt32 mix_frames = (UInt32)ceil((last - voice.cursor) / voice.step);
+	if (mix_frames > frame_count)
+		mix_frames = frame_count;
+	while (mix_frames > 0 && voice.cursor + (mix_frames - 1) * voice.step >= last)
+		mix_frames--;
+
+	const float left_gain = voice.left_gain / 32768.0f;
+	const float right_gain = voice.right_gain / 32768.0f;
+	double cursor = voice.cursor;
+	UInt32 frame = 0;
+
+#ifdef SOFTWARE_MIXER_SSE
+	const __m128 left_gain4 = _mm_set1_ps(left_gain);
+	const __m128 right_gain4 = _mm_set1_ps(right_gain);
+
+	for (; frame + 4 <= mix_frames; frame += 4)
+	{
+		// the source positions aren't contiguous once resampled, so the loads are gathered
+		Int32 left_a[4], left_b[4], right_a[4], right_b[4];
+		float fraction[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			const double position = cursor + lane * voice.step;
+			const UInt32 index = (UInt32)position;
+			const Int16* source = frames + index * channels;
+
+			fraction[lane] = (float)(position - index);
+			left_a[lane] = source[0];
+			right_a[lane] = source[right_offset];
+			left_b[lane] = source[channels];
+			right_b[lane] = source[channels + right_offset];
+		}
+		cursor += 4.0 * voice.step;
+
+		const __m128 t = _mm_loadu_ps(fraction);
+		const __m128 la = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)left_a));
+		const __m128 lb = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)left_b));
+		const __m128 ra = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)right_a));
+		const __m128 rb = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)right_b));
+
+		const __m128 left = _mm_mul_ps(_mm_add_ps(la, _mm_mul_ps(_mm_sub_ps(lb, la), t)), left_gain4);
+		const __m128 right = _mm_mul_ps(_mm_add_ps(ra, _mm_mul_ps(_mm_sub_ps(rb, ra), t)), right_gain4);
+
+		// back to l r l r
+		float* dest = out + frame * 2;
+		_mm_storeu_ps(dest, _mm_add_ps(_mm_loadu_ps(dest), _mm_unpacklo_ps(left, right)));
+		_mm_storeu_ps(dest + 4, _mm_add_ps(_mm_loadu_ps(dest + 4), _mm_unpackhi_ps(left, right)));
+	}
+#endif
+
+	for (; frame < mix_frames; ++frame)
+	{
+		const UInt32 index = (UInt32)cursor;
+		const float t = (float)(cursor - index);
+		const Int16* source = frames + index * channels;
+
+		out[frame * 2] += (source[0] + (source[channels] - source[0]) * t) * left_gain;
+		out[frame * 2 + 1] += (source[right_offset] + (source[channels + right_offset] - source[right_offset]) * t) * right_gain;
+		cursor += voice.step;
+	}
+
+	voice.cursor = cursor;
+	return mix_frames == frame_count;
+}
+
+float SoftwareMixer::voice_us_per_ms() const
+{
+	const double output_ms = voice_frames_mixed_ / (kOutputRate / 1000.0);
+	return output_ms > 0.0 ? (float)(voice_time_us_ / output_ms) : 0.0f;
+}
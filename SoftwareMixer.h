@@ -0,0 +1,103 @@
+#ifndef _SOFTWARE_MIXER_H
+#define _SOFTWARE_MIXER_H
+
+#include "VoicePool.h"
+#include <string>
+#include <vector>
+
+class MusicStream;
+
+// where mixed audio goes, interleaved stereo floats in -1..1
+class AudioSink
+{
+public:
+	virtual ~AudioSink() {}
+	virtual void Write(const float* frames, UInt32 frame_count) = 0;
+};
+
+// throws the audio away, for timing the mixer on its own
+class NullAudioSink : public AudioSink
+{
+public:
+	NullAudioSink();
+	void Write(const float* frames, UInt32 frame_count);
+
+	inline UInt32 frames_written() const { return frames_written_; }
+
+private:
+	UInt32 frames_written_;
+};
+
+// writes the mix to a 16 bit stereo wav so it can be listened to afterwards
+class WavFileSink : public AudioSink
+{
+public:
+	WavFileSink();
+	~WavFileSink();
+
+	bool Open(const char* filename, UInt32 sample_rate);
+	void Close();
+	void Write(const float* frames, UInt32 frame_count);
+
+private:
+	FILE* file_;
+	UInt32 sample_rate_;
+	UInt32 data_size_;
+	std::vector<Int16> buffer_;
+};
+
+// mixes the voice pool's voices from the sample bank on the CPU, resampling each to
+// the output rate with linear interpolation, four output frames at a time with SSE.
+// music comes from a MusicStream. the result goes to an AudioSink each update
+class SoftwareMixer : public AudioOutput
+{
+public:
+	static const UInt32 kOutputRate = 44100;
+
+	SoftwareMixer();
+
+	void Init(const SampleBank* bank, AudioSink* sink);
+
+	inline void set_music(MusicStream* music, float volume) { music_ = music; music_volume_ = volume; }
+
+	void StartVoice(int voice_num, const Voice& voice);
+	void StopVoice(int voice_num);
+	void Mix(const Voice* voices, int voice_count, float frame_time);
+
+	// the last update's mix, and the average cost of one voice over a millisecond of output
+	inline float mix_time_ms() const { return mix_time_ms_; }
+	float voice_us_per_ms() const;
+	inline UInt32 frames_mixed() const { return frames_mixed_; }
+
+private:
+	struct MixerVoice
+	{
+		int sample;
+		double cursor;
+		double step;
+		float left_gain;
+		float right_gain;
+		bool active;
+	};
+
+	// adds frame_count frames of the voice into out, false once it has run off the end
+	bool MixVoice(MixerVoice& voice, float* out, UInt32 frame_count);
+
+	const SampleBank* bank_;
+	AudioSink* sink_;
+	MusicStream* music_;
+	float music_volume_;
+
+	MixerVoice voices_[VoicePool::kMaxVoices];
+	std::vector<float> mix_buffer_;
+
+	// the part of a frame left over from the last update's frame_time
+	double frame_carry_;
+
+	float mix_time_ms_;
+	UInt32 frames_mixed_;
+	double voice_time_us_;
+	double voice_frames_mixed_;
+};
+
+#endif // _SOFTWARE_MIXER_H
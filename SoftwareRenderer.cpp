@@ -0,0 +1,344 @@
+#include "SoftwareRenderer.h"
+#include "JobSystem.h"
+#include <graphics/mesh_instance.h>
+#include <graphics/mesh.h>
+#include <graphics/sprite.h>
+#include <maths/aabb.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <math.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SOFTWARE_RENDERER_SSE
+#endif
+
+static const int kTileSize = 32;
+
+// tiles per job when rasterising
+static const int kTileGrain = 4;
+
+// anything closer to the eye than this is dropped rather than clipped
+static const float kNearW = 0.01f;
+
+// the 12 triangles of a box, corners numbered by their bits (x = 1, y = 2, z = 4)
+static const int kBoxIndices[36] =
+{
+	0, 2, 1, 1, 2, 3,	// -z
+	4, 5, 6, 5, 7, 6,	// +z
+	0, 1, 4, 1, 5, 4,	// -y
+	2, 6, 3, 3, 6, 7,	// +y
+	0, 4, 2, 2, 4, 6,	// -x
+	1, 3, 5, 3, 7, 5	// +x
+};
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, JobSystem* job_system) :
+	width_(width),
+	height_(height),
+	tiles_x_((width + kTileSize - 1) / kTileSize),
+	tiles_y_((height + kTileSize - 1) / kTileSize),
+	job_system_(job_system),
+	binned_count_(0),
+	raster_time_ms_(0.0f)
+{
+	projection_matrix_.SetIdentity();
+	view_matrix_.SetIdentity();
+
+	colour_buffer_.resize(width_ * height_);
+	depth_buffer_.resize(width_ * height_);
+	bins_.resize(tiles_x_ * tiles_y_);
+}
+
+void SoftwareRenderer::Begin(UInt32 clear_colour)
+{
+	std::fill(colour_buffer_.begin(), colour_buffer_.end(), clear_colour);
+	std::fill(depth_buffer_.begin(), depth_buffer_.end(), 1.0f);
+
+	// bins keep their capacity between frames
+	triangles_.clear();
+	for (size_t bin = 0; bin < bins_.size(); ++bin)
+		bins_[bin].clear();
+	binned_count_ = 0;
+}
+
+void SoftwareRenderer::End()
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	const int tile_count = tiles_x_ * tiles_y_;
+	if (job_system_)
+	{
+		job_system_->ParallelFor(tile_count, kTileGrain, [this](int begin, int end)
+		{
+			for (int tile = begin; tile < end; ++tile)
+				RasteriseTile(tile);
+		});
+	}
+	else
+	{
+		for (int tile = 0; tile < tile_count; ++tile)
+			RasteriseTile(tile);
+	}
+
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+	raster_time_ms_ = elapsed.count();
+}
+
+void SoftwareRenderer::DrawMesh(const gef::MeshInstance& mesh_instance, UInt32 colour)
+{
+	const gef::Mesh* mesh = mesh_instance.mesh();
+	if (!mesh)
+		return;
+
+	DrawBox(mesh_instance.transform(), mesh->aabb().min_vtx(), mesh->aabb().max_vtx(), colour);
+}
+
+void SoftwareRenderer::DrawBox(const gef::Matrix44& world, const gef::Vector4& min, const gef::Vector4& max, UInt32 colour)
+{
+	// rows are vectors in gef, so a point goes through world, view then projection
+	const gef::Matrix44 world_view_projection = world * view_matrix_ * projection_matrix_;
+
+	float clip[8][4];
+	for (int corner = 0; corner < 8; ++corner)
+	{
+		const float x = (corner & 1) ? max.x() : min.x();
+		const float y = (corner & 2) ? max.y() : min.y();
+		const float z = (corner & 4) ? max.z() : min.z();
+		for (int column = 0; column < 4; ++column)
+		{
+			clip[corner][column] = x * world_view_projection.m(0, column) + y * world_view_projection.m(1, column) +
+				z * world_view_projection.m(2, column) + world_view_projection.m(3, column);
+		}
+	}
+
+	for (int index = 0; index < 36; index += 3)
+		AddClipTriangle(clip[kBoxIndices[index]], clip[kBoxIndices[index + 1]], clip[kBoxIndices[index + 2]], colour);
+}
+
+void SoftwareRenderer::DrawQuad(float x, float y, float width, float height, UInt32 colour)
+{
+	const float left = x - width * 0.5f;
+	const float right = x + width * 0.5f;
+	const float top = y - height * 0.5f;
+	const float bottom = y + height * 0.5f;
+
+	const float v0[3] = { left, top, 0.0f };
+	const float v1[3] = { right, top, 0.0f };
+	const float v2[3] = { left, bottom, 0.0f };
+	const float v3[3] = { right, bottom, 0.0f };
+
+	AddTriangle(v0, v1, v2, colour, false);
+	AddTriangle(v1, v3, v2, colour, false);
+}
+
+void SoftwareRenderer::DrawSprite(const gef::Sprite& sprite)
+{
+	DrawQuad(sprite.position().x(), sprite.position().y(), sprite.width(), sprite.height(), sprite.colour());
+}
+
+void SoftwareRenderer::AddClipTriangle(const float* c0, const float* c1, const float* c2, UInt32 colour)
+{
+	if (c0[3] < kNearW || c1[3] < kNearW || c2[3] < kNearW)
+		return;
+
+	// to pixels, y down like the sprite renderer
+	const float* clip[3] = { c0, c1, c2 };
+	float screen[3][3];
+	for (int vertex = 0; vertex < 3; ++vertex)
+	{
+		const float inv_w = 1.0f / clip[vertex][3];
+		screen[vertex][0] = (clip[vertex][0] * inv_w * 0.5f + 0.5f) * (float)width_;
+		screen[vertex][1] = (0.5f - clip[vertex][1] * inv_w * 0.5f) * (float)height_;
+		screen[vertex][2] = clip[vertex][2] * inv_w;
+	}
+
+	AddTriangle(screen[0], screen[1], screen[2], colour, true);
+}
+
+void SoftwareRenderer::AddTriangle(const float* v0, const float* v1, const float* v2, UInt32 colour, bool depth_test)
+{
+	float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v1[1] - v0[1]) * (v2[0] - v0[0]);
+	if (fabsf(area) < 1e-6f)
+		return;
+
+	// either winding is drawn, flip to the one where inside is positive
+	if (area < 0.0f)
+	{
+		std::swap(v1, v2);
+		area = -area;
+	}
+
+	Triangle triangle;
+	const float* vertices[3] = { v0, v1, v2 };
+	for (int edge = 0; edge < 3; ++edge)
+	{
+		// edge opposite vertex edge, from a to b
+		const float* a = vertices[(edge + 1) % 3];
+		const float* b = vertices[(edge + 2) % 3];
+		triangle.edge_a[edge] = a[1] - b[1];
+		triangle.edge_b[edge] = b[0] - a[0];
+		triangle.edge_c[edge] = (b[1] - a[1]) * a[0] - (b[0] - a[0]) * a[1];
+		triangle.z[edge] = vertices[edge][2];
+	}
+	triangle.inv_area = 1.0f / area;
+	triangle.colour = colour;
+	triangle.depth_test = depth_test;
+
+	triangle.min_x = std::max(0, (int)floorf(std::min(v0[0], std::min(v1[0], v2[0]))));
+	triangle.min_y = std::max(0, (int)floorf(std::min(v0[1], std::min(v1[1], v2[1]))));
+	triangle.max_x = std::min(width_ - 1, (int)ceilf(std::max(v0[0], std::max(v1[0], v2[0]))));
+	triangle.max_y = std::min(height_ - 1, (int)ceilf(std::max(v0[1], std::max(v1[1], v2[1]))));
+	if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y)
+		return;
+
+	const int index = (int)triangles_.size();
+	triangles_.push_back(triangle);
+
+	// bin into every tile the bounds touch, in submission order so overdraw stays in order
+	const int tile_x0 = triangle.min_x / kTileSize;
+	const int tile_y0 = triangle.min_y / kTileSize;
+	const int tile_x1 = triangle.max_x / kTileSize;
+	const int tile_y1 = triangle.max_y / kTileSize;
+	for (int tile_y = tile_y0; tile_y <= tile_y1; ++tile_y)
+	{
+		for (int tile_x = tile_x0; tile_x <= tile_x1; ++tile_x)
+		{
+			bins_[tile_y * tiles_x_ + tile_x].push_back(index);
+			binned_count_++;
+		}
+	}
+}
+
+void SoftwareRenderer::RasteriseTile(int tile)
+{
+	const int tile_x0 = (tile % tiles_x_) * kTileSize;
+	const int tile_y0 = (tile / tiles_x_) * kTileSize;
+	const int tile_x1 = std::min(tile_x0 + kTileSize, width_) - 1;
+	const int tile_y1 = std::min(tile_y0 + kTileSize, height_) - 1;
+
+	const std::vector<int>& bin = bins_[tile];
+	for (size_t i = 0; i < bin.size(); ++i)
+		RasteriseTriangle(triangles_[bin[i]], tile_x0, tile_y0, tile_x1, tile_y1);
+}
+
+void SoftwareRenderer::RasteriseTriangle(const Triangle& triangle, int tile_x0, int tile_y0, int tile_x1, int tile_y1)
+{
+	const int x0 = std::max(triangle.min_x, tile_x0);
+	const int y0 = std::max(triangle.min_y, tile_y0);
+	const int x1 = std::min(triangle.max_x, tile_x1);
+	const int y1 = std::min(triangle.max_y, tile_y1);
+
+	// depth is interpolated in screen space, w0 * z0 + w1 * z1 + w2 * z2 over the area
+	const float z0 = triangle.z[0] * triangle.inv_area;
+	const float z1 = triangle.z[1] * triangle.inv_area;
+	const float z2 = triangle.z[2] * triangle.inv_area;
+
+#ifdef SOFTWARE_RENDERER_SSE
+	const __m128 lane_offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 edge_a0 = _mm_set1_ps(triangle.edge_a[0]);
+	const __m128 edge_a1 = _mm_set1_ps(triangle.edge_a[1]);
+	const __m128 edge_a2 = _mm_set1_ps(triangle.edge_a[2]);
+	const __m128 z0_4 = _mm_set1_ps(z0);
+	const __m128 z1_4 = _mm_set1_ps(z1);
+	const __m128 z2_4 = _mm_set1_ps(z2);
+	const __m128i colour_4 = _mm_set1_epi32((int)triangle.colour);
+#endif
+
+	for (int y = y0; y <= y1; ++y)
+	{
+		const float pixel_y = (float)y + 0.5f;
+		const float row_w0 = triangle.edge_b[0] * pixel_y + triangle.edge_c[0];
+		const float row_w1 = triangle.edge_b[1] * pixel_y + triangle.edge_c[1];
+		const float row_w2 = triangle.edge_b[2] * pixel_y + triangle.edge_c[2];
+
+		UInt32* colour_row = &colour_buffer_[y * width_];
+		float* depth_row = &depth_buffer_[y * width_];
+		int x = x0;
+
+#ifdef SOFTWARE_RENDERER_SSE
+		// four pixels at a time while a whole group fits in the span
+		for (; x + 3 <= x1; x += 4)
+		{
+			const __m128 pixel_x = _mm_add_ps(_mm_set1_ps((float)x), lane_offsets);
+			const __m128 w0 = _mm_add_ps(_mm_mul_ps(edge_a0, pixel_x), _mm_set1_ps(row_w0));
+			const __m128 w1 = _mm_add_ps(_mm_mul_ps(edge_a1, pixel_x), _mm_set1_ps(row_w1));
+			const __m128 w2 = _mm_add_ps(_mm_mul_ps(edge_a2, pixel_x), _mm_set1_ps(row_w2));
+
+			__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero));
+			if (_mm_movemask_ps(inside) == 0)
+				continue;
+
+			if (triangle.depth_test)
+			{
+				const __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, z0_4), _mm_mul_ps(w1, z1_4)), _mm_mul_ps(w2, z2_4));
+				const __m128 depth = _mm_loadu_ps(depth_row + x);
+				inside = _mm_and_ps(inside, _mm_cmplt_ps(z, depth));
+				_mm_storeu_ps(depth_row + x, _mm_or_ps(_mm_and_ps(inside, z), _mm_andnot_ps(inside, depth)));
+			}
+
+			const __m128i mask = _mm_castps_si128(inside);
+			const __m128i colour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colour_row + x));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(colour_row + x), _mm_or_si128(_mm_and_si128(mask, colour_4), _mm_andnot_si128(mask, colour)));
+		}
+#endif
+
+		// the rest of the span, or all of it without SSE
+		for (; x <= x1; ++x)
+		{
+			const float pixel_x = (float)x + 0.5f;
+			const float w0 = triangle.edge_a[0] * pixel_x + row_w0;
+			const float w1 = triangle.edge_a[1] * pixel_x + row_w1;
+			const float w2 = triangle.edge_a[2] * pixel_x + row_w2;
+			if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+				continue;
+
+			if (triangle.depth_test)
+			{
+				const float z = w0 * z0 + w1 * z1 + w2 * z2;
+				if (z >= depth_row[x])
+					continue;
+				depth_row[x] = z;
+			}
+
+			colour_row[x] = triangle.colour;
+		}
+	}
+}
+
+bool SoftwareRenderer::SaveTGA(const char* filename) const
+{
+	FILE* file = fopen(filename, "wb");
+	if (!file)
+		return false;
+
+	// uncompressed true colour, 32 bits, origin top left
+	UInt8 header[18] = { 0 };
+	header[2] = 2;
+	header[12] = (UInt8)(width_ & 0xff);
+	header[13] = (UInt8)(width_ >> 8);
+	header[14] = (UInt8)(height_ & 0xff);
+	header[15] = (UInt8)(height_ >> 8);
+	header[16] = 32;
+	header[17] = 0x28;
+	fwrite(header, 1, sizeof(header), file);
+
+	// colours are packed ABGR like gef's, tga wants BGRA bytes
+	std::vector<UInt8> row(width_ * 4);
+	for (int y = 0; y < height_; ++y)
+	{
+		for (int x = 0; x < width_; ++x)
+		{
+			const UInt32 colour = colour_buffer_[y * width_ + x];
+			row[x * 4 + 0] = (UInt8)((colour >> 16) & 0xff);
+			row[x * 4 + 1] = (UInt8)((colour >> 8) & 0xff);
+			row[x * 4 + 2] = (UInt8)(colour & 0xff);
+			row[x * 4 + 3] = (UInt8)(colour >> 24);
+		}
+		fwrite(&row[0], 1, row.size(), file);
+	}
+
+	fclose(file);
+	return true;
+}
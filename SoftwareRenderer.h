@@ -0,0 +1,93 @@
+#ifndef _SOFTWARE_RENDERER_H
+#define _SOFTWARE_RENDERER_H
+
+#include <gef.h>
+#include <maths/matrix44.h>
+#include <maths/vector4.h>
+#include <vector>
+
+namespace gef
+{
+	class MeshInstance;
+	class Sprite;
+}
+
+class JobSystem;
+
+// CPU stand in for the bits of Renderer3D / SpriteRenderer the game uses, for
+// machines without D3D11. meshes are drawn as their bounding boxes and sprites
+// as flat quads, which is enough for a realistic idea of the fill and vertex
+// cost. triangles are binned into screen tiles and the tiles rasterised in
+// parallel, four pixels at a time where SSE is available.
+class SoftwareRenderer
+{
+public:
+	SoftwareRenderer(int width, int height, JobSystem* job_system);
+
+	inline void set_projection_matrix(const gef::Matrix44& projection_matrix) { projection_matrix_ = projection_matrix; }
+	inline void set_view_matrix(const gef::Matrix44& view_matrix) { view_matrix_ = view_matrix; }
+
+	// clears colour and depth and starts collecting triangles
+	void Begin(UInt32 clear_colour);
+
+	// rasterises everything collected since Begin
+	void End();
+
+	void DrawMesh(const gef::MeshInstance& mesh_instance, UInt32 colour);
+
+	// box between min and max in model space, transformed by world
+	void DrawBox(const gef::Matrix44& world, const gef::Vector4& min, const gef::Vector4& max, UInt32 colour);
+
+	// screen space quad centred on x, y, drawn over whatever is there
+	void DrawQuad(float x, float y, float width, float height, UInt32 colour);
+	void DrawSprite(const gef::Sprite& sprite);
+
+	// uncompressed 32 bit tga of the last frame
+	bool SaveTGA(const char* filename) const;
+
+	inline const UInt32* pixels() const { return &colour_buffer_[0]; }
+	inline int width() const { return width_; }
+	inline int height() const { return height_; }
+
+	inline int triangle_count() const { return (int)triangles_.size(); }
+	inline int binned_count() const { return binned_count_; }
+	inline float raster_time_ms() const { return raster_time_ms_; }
+
+private:
+	// screen space triangle with its edge functions set up, w = a*x + b*y + c for each edge
+	struct Triangle
+	{
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		float z[3];
+		float inv_area;
+		int min_x, min_y, max_x, max_y;
+		UInt32 colour;
+		bool depth_test;
+	};
+
+	void AddTriangle(const float* v0, const float* v1, const float* v2, UInt32 colour, bool depth_test);
+	void AddClipTriangle(const float* c0, const float* c1, const float* c2, UInt32 colour);
+	void RasteriseTile(int tile);
+	void RasteriseTriangle(const Triangle& triangle, int tile_x0, int tile_y0, int tile_x1, int tile_y1);
+
+	int width_;
+	int height_;
+	int tiles_x_;
+	int tiles_y_;
+	JobSystem* job_system_;
+
+	gef::Matrix44 projection_matrix_;
+	gef::Matrix44 view_matrix_;
+
+	std::vector<UInt32> colour_buffer_;
+	std::vector<float> depth_buffer_;
+
+	std::vector<Triangle> triangles_;
+	std::vector<std::vector<int> > bins_;
+	int binned_count_;
+	float raster_time_ms_;
+};
+
+#endif // _SOFTWARE_RENDERER_H
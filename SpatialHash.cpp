@@ -0,0 +1,155 @@
+#include "SpatialHash.h"
+#include <math.h>
+#include <algorithm>
+
+SpatialHash::SpatialHash() :
+	half_width_(0.0f),
+	half_height_(0.0f),
+	cell_size_(1.0f),
+	inv_cell_size_(1.0f),
+	cells_x_(0),
+	cells_y_(0),
+	positions_(NULL),
+	count_(0)
+{
+}
+
+void SpatialHash::Init(float half_width, float half_height, float cell_size)
+{
+	half_width_ = half_width;
+	half_height_ = half_height;
+	cell_size_ = cell_size;
+	inv_cell_size_ = 1.0f / cell_size;
+	cells_x_ = (int)ceilf(2.0f * half_width * inv_cell_size_);
+	cells_y_ = (int)ceilf(2.0f * half_height * inv_cell_size_);
+
+	cell_start_.resize(cells_x_ * cells_y_ + 1);
+}
+
+void SpatialHash::CellCoords(const b2Vec2& position, int& x, int& y) const
+{
+	x = (int)((position.x + half_width_) * inv_cell_size_);
+	y = (int)((position.y + half_height_) * inv_cell_size_);
+
+	if (x < 0) x = 0;
+	if (x >= cells_x_) x = cells_x_ - 1;
+	if (y < 0) y = 0;
+	if (y >= cells_y_) y = cells_y_ - 1;
+}
+
+int SpatialHash::CellIndex(const b2Vec2& position) const
+{
+	int x, y;
+	CellCoords(position, x, y);
+	return y * cells_x_ + x;
+}
+
+void SpatialHash::Build(const b2Vec2* positions, int count)
+{
+	positions_ = positions;
+	count_ = count;
+
+	sorted_.resize(count);
+	item_cell_.resize(count);
+
+	// count items per cell
+	std::fill(cell_start_.begin(), cell_start_.end(), 0);
+	for (int i = 0; i < count; ++i)
+	{
+		item_cell_[i] = CellIndex(positions[i]);
+		cell_start_[item_cell_[i] + 1]++;
+	}
+
+	// prefix sum gives the start of each cell
+	const int num_cells = cells_x_ * cells_y_;
+	for (int c = 0; c < num_cells; ++c)
+		cell_start_[c + 1] += cell_start_[c];
+
+	// scatter each item to the next free slot in its cell
+	cursor_.assign(cell_start_.begin(), cell_start_.end() - 1);
+	for (int i = 0; i < count; ++i)
+		sorted_[cursor_[item_cell_[i]]++] = i;
+}
+
+int SpatialHash::Query(const b2Vec2& position, float radius, int* results, int max_results) const
+{
+	int min_x, min_y, max_x, max_y;
+	CellCoords(b2Vec2(position.x - radius, position.y - radius), min_x, min_y);
+	CellCoords(b2Vec2(position.x + radius, position.y + radius), max_x, max_y);
+
+	const float radius_sq = radius * radius;
+	int num_results = 0;
+
+	for (int y = min_y; y <= max_y; ++y)
+	{
+		for (int x = min_x; x <= max_x; ++x)
+		{
+			const int cell = y * cells_x_ + x;
+			for (int s = cell_start_[cell]; s < cell_start_[cell + 1]; ++s)
+			{
+				const int item = sorted_[s];
+				b2Vec2 delta = positions_[item] - position;
+				if (delta.LengthSquared() <= radius_sq)
+				{
+					if (num_results == max_results)
+						return num_results;
+					results[num_results++] = item;
+				}
+			}
+		}
+	}
+
+	return num_results;
+}
+
+void SpatialHash::ComputeSeparation(float radius, float strength, b2Vec2* out) const
+{
+	ComputeSeparation(radius, strength, out, 0, count_);
+}
+
+void SpatialHash::ComputeSeparation(float radius, float strength, b2Vec2* out, int begin, int end) const
+{
+	const float radius_sq = radius * radius;
+
+	for (int i = begin; i < end; ++i)
+	{
+		const b2Vec2& position = positions_[i];
+		b2Vec2 push(0.0f, 0.0f);
+
+		int min_x, min_y, max_x, max_y;
+		CellCoords(b2Vec2(position.x - radius, position.y - radius), min_x, min_y);
+		CellCoords(b2Vec2(position.x + radius, position.y + radius), max_x, max_y);
+
+		for (int y = min_y; y <= max_y; ++y)
+		{
+			for (int x = min_x; x <= max_x; ++x)
+			{
+				const int cell = y * cells_x_ + x;
+				for (int s = cell_start_[cell]; s < cell_start_[cell + 1]; ++s)
+				{
+					const int other = sorted_[s];
+					if (other == i)
+						continue;
+
+					b2Vec2 delta = position - positions_[other];
+					float dist_sq = delta.LengthSquared();
+					if (dist_sq >= radius_sq)
+						continue;
+
+					// stacked exactly on top of each other, split them along x by index
+					if (dist_sq < 1e-6f)
+					{
+						push.x += (i < other) ? -1.0f : 1.0f;
+						continue;
+					}
+
+					// falls off linearly to nothing at the edge of the radius
+					float dist = sqrtf(dist_sq);
+					push += ((radius - dist) / (radius * dist)) * delta;
+				}
+			}
+		}
+
+		out[i] = strength * push;
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef _SPATIAL_HASH_H
+#define _SPATIAL_HASH_H
+
+#include <box2d/Box2D.h>
+#include <vector>
+
+// uniform grid over the arena, rebuilt every step with a counting sort so
+// the items in each cell end up contiguous
+class SpatialHash
+{
+public:
+	SpatialHash();
+
+	// half_width / half_height cover the arena, anything outside is clamped into the edge cells
+	void Init(float half_width, float half_height, float cell_size);
+
+	void Build(const b2Vec2* positions, int count);
+
+	// collects the index of every item within radius of position, up to max_results
+	int Query(const b2Vec2& position, float radius, int* results, int max_results) const;
+
+	// separation steering, pushes each item away from neighbours closer than radius
+	// and writes the velocity change into out (count entries)
+	void ComputeSeparation(float radius, float strength, b2Vec2* out) const;
+
+	// same for items [begin, end) only, read only so ranges can run on different threads
+	void ComputeSeparation(float radius, float strength, b2Vec2* out, int begin, int end) const;
+
+	inline int cell_count() const { return cells_x_ * cells_y_; }
+
+private:
+	int CellIndex(const b2Vec2& position) const;
+	void CellCoords(const b2Vec2& position, int& x, int& y) const;
+
+	float half_width_;
+	float half_height_;
+	float cell_size_;
+	float inv_cell_size_;
+	int cells_x_;
+	int cells_y_;
+
+	const b2Vec2* positions_;
+	int count_;
+
+	// cell_start_[c]..cell_start_[c+1] index into sorted_
+	std::vector<int> cell_start_;
+	std::vector<int> sorted_;
+	std::vector<int> item_cell_;
+	std::vector<int> cursor_;
+};
+
+#endif // _SPATIAL_HASH_H
@@ -0,0 +1,54 @@
+#include "SpawnQueue.h"
+
+SpawnQueue::SpawnQueue() :
+	half_width_(0.0f),
+	half_height_(0.0f),
+	next_(kBatchSize)
+{
+}
+
+void SpawnQueue::Init(UInt32 seed, float half_width, float half_height)
+{
+	random_.Seed(seed, RNG_ENEMY_SPAWN);
+	half_width_ = half_width;
+	half_height_ = half_height;
+
+	// force a refill on the first Next
+	next_ = kBatchSize;
+}
+
+b2Vec2 SpawnQueue::Next()
+{
+	if (next_ >= kBatchSize)
+		Refill();
+
+	return positions_[next_++];
+}
+
+void SpawnQueue::Refill()
+{
+	// one draw for the position along the edge, then the edge itself
+	float along[kBatchSize];
+	random_.Fill(along, kBatchSize, -1.0f, 1.0f);
+
+	for (int i = 0; i < kBatchSize; ++i)
+	{
+		switch (random_.NextUInt32() & 3)
+		{
+		case 0: // top
+			positions_[i].Set(along[i] * half_width_, half_height_);
+			break;
+		case 1: // bottom
+			positions_[i].Set(along[i] * half_width_, -half_height_);
+			break;
+		case 2: // left
+			positions_[i].Set(-half_width_, along[i] * half_height_);
+			break;
+		default: // right
+			positions_[i].Set(half_width_, along[i] * half_height_);
+			break;
+		}
+	}
+
+	next_ = 0;
+}
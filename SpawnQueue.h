@@ -0,0 +1,34 @@
+#ifndef _SPAWN_QUEUE_H
+#define _SPAWN_QUEUE_H
+
+#include <box2d/Box2D.h>
+#include "Random.h"
+
+// pre-generates enemy spawn points along the four edges of the arena in batches,
+// so the random draws happen together and can later be done off the main thread
+class SpawnQueue
+{
+public:
+	SpawnQueue();
+
+	// half_width / half_height are the inside edges of the arena
+	void Init(UInt32 seed, float half_width, float half_height);
+
+	b2Vec2 Next();
+
+	inline Random& random() { return random_; }
+
+private:
+	void Refill();
+
+	static const int kBatchSize = 64;
+
+	Random random_;
+	float half_width_;
+	float half_height_;
+
+	b2Vec2 positions_[kBatchSize];
+	int next_;
+};
+
+#endif // _SPAWN_QUEUE_H
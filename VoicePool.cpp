@@ -0,0 +1,247 @@
+#include "VoicePool.h"
+#include "SampleBank.h"
+#include <audio/audio_manager.h>
+
+NullAudioOutput::NullAudioOutput() :
+	voices_started_(0),
+	voices_mixed_(0),
+	peak_voices_(0)
+{
+}
+
+void NullAudioOutput::StartVoice(int, const Voice&)
+{
+	voices_started_++;
+}
+
+void NullAudioOutput::StopVoice(int)
+{
+}
+
+void NullAudioOutput::Mix(const Voice* voices, int voice_count, float)
+{
+	int active = 0;
+	for (int voice_num = 0; voice_num < voice_count; ++voice_num)
+	{
+		if (voices[voice_num].active)
+			active++;
+	}
+
+	voices_mixed_ += active;
+	if (active > peak_voices_)
+		peak_voices_ = active;
+}
+
+GefAudioOutput::GefAudioOutput() :
+	audio_manager_(NULL),
+	gef_voices_(VoicePool::kMaxVoices, -1)
+{
+}
+
+void GefAudioOutput::Init(gef::AudioManager* audio_manager)
+{
+	audio_manager_ = audio_manager;
+	gef_samples_.clear();
+}
+
+void GefAudioOutput::AddSample(Int32 gef_sample)
+{
+	gef_samples_.push_back(gef_sample);
+}
+
+void GefAudioOutput::StartVoice(int voice_num, const Voice& voice)
+{
+	if (!audio_manager_ || voice.sample >= (int)gef_samples_.size() || gef_samples_[voice.sample] < 0)
+		return;
+
+	const Int32 gef_voice = audio_manager_->PlaySample(gef_samples_[voice.sample], false);
+
+	// gef hands out voices that have finished by themselves again, so anything of ours
+	// still pointing at this one mustn't stop it later
+	for (size_t other = 0; other < gef_voices_.size(); ++other)
+	{
+		if (gef_voices_[other] == gef_voice)
+			gef_voices_[other] = -1;
+	}
+
+	gef_voices_[voice_num] = gef_voice;
+}
+
+void GefAudioOutput::StopVoice(int voice_num)
+{
+	if (audio_manager_ && gef_voices_[voice_num] >= 0)
+		audio_manager_->StopPlayingSampleVoice(gef_voices_[voice_num]);
+
+	gef_voices_[voice_num] = -1;
+}
+
+void GefAudioOutput::Mix(const Voice*, int, float)
+{
+	// OpenAL mixes on its own
+}
+
+VoicePool::VoicePool() :
+	bank_(NULL),
+	output_(NULL),
+	next_start_order_(0),
+	time_(0.0),
+	plays_(0),
+	steals_(0),
+	limited_(0)
+{
+	for (int voice_num = 0; voice_num < kMaxVoices; ++voice_num)
+		voices_[voice_num].active = false;
+}
+
+void VoicePool::Init(const SampleBank* bank, AudioOutput* output)
+{
+	StopAll();
+
+	bank_ = bank;
+	output_ = output;
+	time_ = 0.0;
+	last_start_.clear();
+	sample_voices_.clear();
+}
+
+int VoicePool::Play(int sample, float volume, float pan)
+{
+	if (!bank_ || sample < 0 || sample >= bank_->sample_count())
+		return -1;
+
+	// samples can be added to the bank after Init
+	if ((int)last_start_.size() < bank_->sample_count())
+	{
+		last_start_.resize(bank_->sample_count(), -1.0e9);
+		sample_voices_.resize(bank_->sample_count(), 0);
+	}
+
+	const SampleLimits& limits = bank_->sample(sample).limits;
+	if (time_ - last_start_[sample] < limits.cooldown)
+	{
+		limited_++;
+		return -1;
+	}
+
+	int chosen = -1;
+	if (sample_voices_[sample] >= limits.max_voices)
+	{
+		// at its limit, restart the oldest copy rather than pile another on
+		for (int voice_num = 0; voice_num < kMaxVoices; ++voice_num)
+		{
+			const Voice& voice = voices_[voice_num];
+			if (voice.active && voice.sample == sample && (chosen < 0 || voice.start_order < voices_[chosen].start_order))
+				chosen = voice_num;
+		}
+	}
+	else
+	{
+		for (int voice_num = 0; voice_num < kMaxVoices && chosen < 0; ++voice_num)
+		{
+			if (!voices_[voice_num].active)
+				chosen = voice_num;
+		}
+
+		// pool's full, take the lowest priority voice, the oldest of those
+		if (chosen < 0)
+		{
+			for (int voice_num = 0; voice_num < kMaxVoices; ++voice_num)
+			{
+				const Voice& voice = voices_[voice_num];
+				if (voice.priority > limits.priority)
+					continue;
+
+				if (chosen < 0 || voice.priority < voices_[chosen].priority
+					|| (voice.priority == voices_[chosen].priority && voice.start_order < voices_[chosen].start_order))
+				{
+					chosen = voice_num;
+				}
+			}
+		}
+	}
+
+	if (chosen < 0)
+	{
+		limited_++;
+		return -1;
+	}
+
+	if (voices_[chosen].active)
+	{
+		Stop(chosen);
+		steals_++;
+	}
+
+	StartVoice(chosen, sample, volume, pan);
+	return chosen;
+}
+
+void VoicePool::StartVoice(int voice_num, int sample, float volume, float pan)
+{
+	Voice& voice = voices_[voice_num];
+	voice.sample = sample;
+	voice.priority = bank_->sample(sample).limits.priority;
+	voice.start_order = next_start_order_++;
+	voice.position = 0.0;
+	voice.volume = volume;
+	voice.pan = pan;
+	voice.active = true;
+
+	last_start_[sample] = time_;
+	sample_voices_[sample]++;
+	plays_++;
+
+	if (output_)
+		output_->StartVoice(voice_num, voice);
+}
+
+void VoicePool::Stop(int voice_num)
+{
+	Voice& voice = voices_[voice_num];
+	if (!voice.active)
+		return;
+
+	voice.active = false;
+	sample_voices_[voice.sample]--;
+
+	if (output_)
+		output_->StopVoice(voice_num);
+}
+
+void VoicePool::StopAll()
+{
+	for (int voice_num = 0; voice_num < kMaxVoices; ++voice_num)
+		Stop(voice_num);
+}
+
+void VoicePool::Update(float frame_time)
+{
+	if (output_)
+		output_->Mix(voices_, kMaxVoices, frame_time);
+
+	time_ += frame_time;
+
+	for (int voice_num = 0; voice_num < kMaxVoices; ++voice_num)
+	{
+		Voice& voice = voices_[voice_num];
+		if (!voice.active)
+			continue;
+
+		const SampleInfo& info = bank_->sample(voice.sample);
+		voice.position += (double)frame_time * info.sample_rate;
+		if (voice.position >= info.frame_count)
+			Stop(voice_num);
+	}
+}
+
+int VoicePool::active_voices() const
+{
+	int active = 0;
+	for (int voice_num = 0; voice_num < kMaxVoices; ++voice_num)
+	{
+		if (voices_[voice_num].active)
+			active++;
+	}
+
+	return active;
+}
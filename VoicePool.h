@@ -0,0 +1,129 @@
+#ifndef _VOICE_POOL_H
+#define _VOICE_POOL_H
+
+#include <gef.h>
+#include <vector>
+
+class SampleBank;
+
+namespace gef
+{
+	class AudioManager;
+}
+
+struct Voice
+{
+	int sample;
+	int priority;
+	UInt32 start_order;
+
+	// in frames of the sample, so at its own rate
+	double position;
+	float volume;
+	float pan;
+	bool active;
+};
+
+// where the pool's voices are actually heard
+class AudioOutput
+{
+public:
+	virtual ~AudioOutput() {}
+
+	// the voice was free, or has just been stopped for this
+	virtual void StartVoice(int voice_num, const Voice& voice) = 0;
+	virtual void StopVoice(int voice_num) = 0;
+
+	// once an update, before the voices move on by frame_time
+	virtual void Mix(const Voice* voices, int voice_count, float frame_time) = 0;
+};
+
+// plays nothing, just counts. for running the game or the tools without audio
+class NullAudioOutput : public AudioOutput
+{
+public:
+	NullAudioOutput();
+
+	void StartVoice(int voice_num, const Voice& voice);
+	void StopVoice(int voice_num);
+	void Mix(const Voice* voices, int voice_count, float frame_time);
+
+	inline UInt32 voices_started() const { return voices_started_; }
+	inline UInt32 voices_mixed() const { return voices_mixed_; }
+	inline int peak_voices() const { return peak_voices_; }
+
+private:
+	UInt32 voices_started_;
+
+	// active voices summed over every Mix
+	UInt32 voices_mixed_;
+	int peak_voices_;
+};
+
+// hands the voices to gef's AudioManager, which has its own copy of each sample
+class GefAudioOutput : public AudioOutput
+{
+public:
+	GefAudioOutput();
+
+	void Init(gef::AudioManager* audio_manager);
+
+	// in bank order, the gef id of each sample
+	void AddSample(Int32 gef_sample);
+
+	void StartVoice(int voice_num, const Voice& voice);
+	void StopVoice(int voice_num);
+	void Mix(const Voice* voices, int voice_count, float frame_time);
+
+private:
+	gef::AudioManager* audio_manager_;
+	std::vector<Int32> gef_samples_;
+	std::vector<Int32> gef_voices_;
+};
+
+// a fixed set of voices shared by every sound effect, so however many collisions
+// there are in a step only so many sounds play. each sample's SampleLimits caps
+// how many of it play at once and how often it can start
+class VoicePool
+{
+public:
+	static const int kMaxVoices = 12;
+
+	VoicePool();
+
+	void Init(const SampleBank* bank, AudioOutput* output);
+
+	// the voice it went to, or -1 if it was limited or everything playing outranks it
+	int Play(int sample, float volume = 1.0f, float pan = 0.0f);
+	void Stop(int voice_num);
+	void StopAll();
+
+	// moves the voices on and frees the ones that have finished
+	void Update(float frame_time);
+
+	int active_voices() const;
+	inline const Voice& voice(int voice_num) const { return voices_[voice_num]; }
+
+	inline UInt32 plays() const { return plays_; }
+	inline UInt32 steals() const { return steals_; }
+	inline UInt32 limited() const { return limited_; }
+
+private:
+	void StartVoice(int voice_num, int sample, float volume, float pan);
+
+	const SampleBank* bank_;
+	AudioOutput* output_;
+	Voice voices_[kMaxVoices];
+	UInt32 next_start_order_;
+
+	// seconds since Init, and per sample when it last started and how many are playing
+	double time_;
+	std::vector<double> last_start_;
+	std::vector<int> sample_voices_;
+
+	UInt32 plays_;
+	UInt32 steals_;
+	UInt32 limited_;
+};
+
+#endif // _VOICE_POOL_H
@@ -0,0 +1,112 @@
+#include "WavFile.h"
+#include <cstring>
+
+static UInt32 ReadUInt32(const UInt8* bytes)
+{
+	return (UInt32)bytes[0] | ((UInt32)bytes[1] << 8) | ((UInt32)bytes[2] << 16) | ((UInt32)bytes[3] << 24);
+}
+
+static UInt16 ReadUInt16(const UInt8* bytes)
+{
+	return (UInt16)(bytes[0] | (bytes[1] << 8));
+}
+
+static void WriteUInt32(UInt8* bytes, UInt32 value)
+{
+	bytes[0] = (UInt8)value;
+	bytes[1] = (UInt8)(value >> 8);
+	bytes[2] = (UInt8)(value >> 16);
+	bytes[3] = (UInt8)(value >> 24);
+}
+
+static void WriteUInt16(UInt8* bytes, UInt16 value)
+{
+	bytes[0] = (UInt8)value;
+	bytes[1] = (UInt8)(value >> 8);
+}
+
+bool ReadWavHeader(FILE* file, WavFormat& format)
+{
+	UInt8 riff[12];
+	if (fread(riff, sizeof(riff), 1, file) != 1 || memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0)
+		return false;
+
+	bool have_format = false;
+	format.format = 0;
+
+	// anything that isn't the format or the data (LIST, fact) is skipped
+	UInt8 chunk[8];
+	while (fread(chunk, sizeof(chunk), 1, file) == 1)
+	{
+		const UInt32 chunk_size = ReadUInt32(chunk + 4);
+
+		if (memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16)
+		{
+			UInt8 fmt[16];
+			if (fread(fmt, sizeof(fmt), 1, file) != 1)
+				return false;
+
+			format.format = ReadUInt16(fmt);
+			format.channels = ReadUInt16(fmt + 2);
+			format.sample_rate = ReadUInt32(fmt + 4);
+			format.bits_per_sample = ReadUInt16(fmt + 14);
+			have_format = true;
+
+			// chunks are padded to an even size
+			fseek(file, (chunk_size - 16) + (chunk_size & 1), SEEK_CUR);
+		}
+		else if (memcmp(chunk, "data", 4) == 0)
+		{
+			format.data_offset = (UInt32)ftell(file);
+
+			// trust the file length over the header, some writers leave the size unfinished
+			fseek(file, 0, SEEK_END);
+			const UInt32 available = (UInt32)ftell(file) - format.data_offset;
+			fseek(file, format.data_offset, SEEK_SET);
+			format.data_size = chunk_size < available ? chunk_size : available;
+
+			return have_format && format.format == kWavFormatPCM
+				&& format.channels >= 1 && format.channels <= 2
+				&& (format.bits_per_sample == 8 || format.bits_per_sample == 16);
+		}
+		else
+		{
+			fseek(file, chunk_size + (chunk_size & 1), SEEK_CUR);
+		}
+	}
+
+	return false;
+}
+
+void DecodePCM(const UInt8* data, UInt32 sample_count, UInt16 bits_per_sample, Int16* samples)
+{
+	for (UInt32 sample_num = 0; sample_num < sample_count; ++sample_num)
+	{
+		if (bits_per_sample == 8)
+			samples[sample_num] = (Int16)(((int)data[sample_num] - 128) << 8);
+		else
+			samples[sample_num] = (Int16)ReadUInt16(data + sample_num * 2);
+	}
+}
+
+void WriteWavHeader(FILE* file, UInt16 channels, UInt32 sample_rate, UInt32 data_size)
+{
+	UInt8 header[44];
+	memcpy(header, "RIFF", 4);
+	WriteUInt32(header + 4, 36 + data_size);
+	memcpy(header + 8, "WAVE", 4);
+
+	memcpy(header + 12, "fmt ", 4);
+	WriteUInt32(header + 16, 16);
+	WriteUInt16(header + 20, kWavFormatPCM);
+	WriteUInt16(header + 22, channels);
+	WriteUInt32(header + 24, sample_rate);
+	WriteUInt32(header + 28, sample_rate * channels * sizeof(Int16));
+	WriteUInt16(header + 32, (UInt16)(channels * sizeof(Int16)));
+	WriteUInt16(header + 34, 16);
+
+	memcpy(header + 36, "data", 4);
+	WriteUInt32(header + 40, data_size);
+
+	fwrite(header, sizeof(header), 1, file);
+}
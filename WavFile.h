@@ -0,0 +1,33 @@
+#ifndef _WAV_FILE_H
+#define _WAV_FILE_H
+
+#include <gef.h>
+#include <cstdio>
+
+static const UInt16 kWavFormatPCM = 1;
+
+struct WavFormat
+{
+	UInt16 format;
+	UInt16 channels;
+	UInt32 sample_rate;
+	UInt16 bits_per_sample;
+
+	// where the sample data starts in the file, and how many bytes of it there are
+	UInt32 data_offset;
+	UInt32 data_size;
+
+	inline UInt32 bytes_per_frame() const { return channels * (bits_per_sample / 8); }
+};
+
+// walks the RIFF chunks as far as the data and leaves the file there. false if it's
+// not a wav, or is one this can't play (anything but 8 or 16 bit PCM, mono or stereo)
+bool ReadWavHeader(FILE* file, WavFormat& format);
+
+// 8 bit wav is unsigned, 16 bit little endian signed
+void DecodePCM(const UInt8* data, UInt32 sample_count, UInt16 bits_per_sample, Int16* samples);
+
+// a 16 bit PCM header, written again with the real size once the data's in
+void WriteWavHeader(FILE* file, UInt16 channels, UInt32 sample_rate, UInt32 data_size);
+
+#endif // _WAV_FILE_H
@@ -0,0 +1,175 @@
+#include "WorldSnapshot.h"
+#include <cstring>
+
+// per body record, written field by field so there's no padding in the blob. the user
+// data is kept to check the bodies still belong to the same entities on restore
+static const UInt32 kBodyRecordSize = sizeof(uintptr_t) + 6 * sizeof(float) + 1;
+
+enum BodyFlags
+{
+	BODY_ENABLED = 1,
+	BODY_AWAKE = 2
+};
+
+static inline void Write(UInt8*& cursor, const void* data, UInt32 size)
+{
+	memcpy(cursor, data, size);
+	cursor += size;
+}
+
+static inline void Read(const UInt8*& cursor, void* data, UInt32 size)
+{
+	memcpy(data, cursor, size);
+	cursor += size;
+}
+
+//
+// WorldSnapshot
+//
+WorldSnapshot::WorldSnapshot()
+{
+}
+
+void WorldSnapshot::Capture(b2World* world, const void* game_state, UInt32 game_state_size)
+{
+	const UInt32 body_count = (UInt32)world->GetBodyCount();
+	data_.resize(sizeof(UInt32) * 2 + game_state_size + body_count * kBodyRecordSize);
+
+	UInt8* cursor = &data_[0];
+	Write(cursor, &body_count, sizeof(UInt32));
+	Write(cursor, &game_state_size, sizeof(UInt32));
+	if (game_state_size > 0)
+		Write(cursor, game_state, game_state_size);
+
+	for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+	{
+		const uintptr_t user_data = body->GetUserData().pointer;
+		const b2Vec2& position = body->GetPosition();
+		const b2Vec2& velocity = body->GetLinearVelocity();
+		const float angle = body->GetAngle();
+		const float angular_velocity = body->GetAngularVelocity();
+		const UInt8 flags = (body->IsEnabled() ? BODY_ENABLED : 0) | (body->IsAwake() ? BODY_AWAKE : 0);
+
+		Write(cursor, &user_data, sizeof(uintptr_t));
+		Write(cursor, &position.x, sizeof(float));
+		Write(cursor, &position.y, sizeof(float));
+		Write(cursor, &angle, sizeof(float));
+		Write(cursor, &velocity.x, sizeof(float));
+		Write(cursor, &velocity.y, sizeof(float));
+		Write(cursor, &angular_velocity, sizeof(float));
+		Write(cursor, &flags, sizeof(UInt8));
+	}
+}
+
+bool WorldSnapshot::Restore(b2World* world, void* game_state, UInt32 game_state_size) const
+{
+	if (data_.empty())
+		return false;
+
+	const UInt8* cursor = &data_[0];
+	UInt32 body_count = 0;
+	UInt32 stored_game_state_size = 0;
+	Read(cursor, &body_count, sizeof(UInt32));
+	Read(cursor, &stored_game_state_size, sizeof(UInt32));
+
+	if (body_count != (UInt32)world->GetBodyCount() || stored_game_state_size != game_state_size)
+		return false;
+
+	const UInt8* stored_game_state = cursor;
+	cursor += game_state_size;
+
+	// every body has to still be the one captured before anything is touched
+	const UInt8* bodies = cursor;
+	for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+	{
+		uintptr_t user_data;
+		memcpy(&user_data, cursor, sizeof(uintptr_t));
+		if (user_data != body->GetUserData().pointer)
+			return false;
+
+		cursor += kBodyRecordSize;
+	}
+
+	if (game_state_size > 0)
+		memcpy(game_state, stored_game_state, game_state_size);
+
+	cursor = bodies;
+	for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+	{
+		b2Vec2 position, velocity;
+		float angle, angular_velocity;
+		UInt8 flags;
+
+		cursor += sizeof(uintptr_t);
+		Read(cursor, &position.x, sizeof(float));
+		Read(cursor, &position.y, sizeof(float));
+		Read(cursor, &angle, sizeof(float));
+		Read(cursor, &velocity.x, sizeof(float));
+		Read(cursor, &velocity.y, sizeof(float));
+		Read(cursor, &angular_velocity, sizeof(float));
+		Read(cursor, &flags, sizeof(UInt8));
+
+		// a body that's been disabled since belongs to an entity that died, one that was
+		// disabled then has been spawned since, either way its manager decides where it is
+		if (!body->IsEnabled() || (flags & BODY_ENABLED) == 0)
+			continue;
+
+		body->SetTransform(position, angle);
+		body->SetLinearVelocity(velocity);
+		body->SetAngularVelocity(angular_velocity);
+		body->SetAwake((flags & BODY_AWAKE) != 0);
+	}
+
+	return true;
+}
+
+//
+// SnapshotRing
+//
+SnapshotRing::SnapshotRing() :
+	interval_(1),
+	frame_(0),
+	newest_(-1),
+	count_(0)
+{
+}
+
+void SnapshotRing::Init(int capacity, int interval)
+{
+	snapshots_.resize(capacity);
+	interval_ = interval > 0 ? interval : 1;
+	Clear();
+}
+
+void SnapshotRing::Clear()
+{
+	frame_ = 0;
+	newest_ = -1;
+	count_ = 0;
+}
+
+void SnapshotRing::Update(b2World* world, const void* game_state, UInt32 game_state_size)
+{
+	if (snapshots_.empty() || (frame_++ % interval_) != 0)
+		return;
+
+	newest_ = (newest_ + 1) % (int)snapshots_.size();
+	snapshots_[newest_].Capture(world, game_state, game_state_size);
+
+	if (count_ < (int)snapshots_.size())
+		count_++;
+}
+
+bool SnapshotRing::Rewind(b2World* world, void* game_state, UInt32 game_state_size)
+{
+	if (count_ == 0)
+		return false;
+
+	const bool restored = snapshots_[newest_].Restore(world, game_state, game_state_size);
+
+	newest_ = (newest_ + (int)snapshots_.size() - 1) % (int)snapshots_.size();
+	count_--;
+	frame_ = 0;
+
+	return restored;
+}
@@ -0,0 +1,58 @@
+#ifndef _WORLD_SNAPSHOT_H
+#define _WORLD_SNAPSHOT_H
+
+#include <box2d/Box2D.h>
+#include <gef.h>
+#include <vector>
+
+// packed copy of every body's transform, velocity and enabled / awake flags, plus a
+// blob of game state from the caller. restoring relies on the world still holding the
+// same bodies in the same order, which holds as long as the managers pool their
+// entities rather than creating and destroying them.
+// whether an entity is alive is the managers' business and they have no way to set
+// it, so a restore never enables or disables a body. only bodies enabled both now and
+// at the capture are moved back, the rest are left where their entity put them.
+class WorldSnapshot
+{
+public:
+	WorldSnapshot();
+
+	void Capture(b2World* world, const void* game_state, UInt32 game_state_size);
+
+	// false if the bodies no longer line up with the capture, nothing is changed then
+	bool Restore(b2World* world, void* game_state, UInt32 game_state_size) const;
+
+	inline UInt32 size() const { return (UInt32)data_.size(); }
+	inline bool empty() const { return data_.empty(); }
+
+private:
+	// reused between captures so a warmed up snapshot never allocates
+	std::vector<UInt8> data_;
+};
+
+// the last capacity snapshots, one every interval frames
+class SnapshotRing
+{
+public:
+	SnapshotRing();
+
+	void Init(int capacity, int interval);
+	void Clear();
+
+	// captures on every interval'th call
+	void Update(b2World* world, const void* game_state, UInt32 game_state_size);
+
+	// restores the newest snapshot and drops it, so repeated calls keep stepping back
+	bool Rewind(b2World* world, void* game_state, UInt32 game_state_size);
+
+	inline int count() const { return count_; }
+
+private:
+	std::vector<WorldSnapshot> snapshots_;
+	int interval_;
+	int frame_;
+	int newest_;
+	int count_;
+};
+
+#endif // _WORLD_SNAPSHOT_H
@@ -1,15 +1,70 @@
-#include <platform/d3d11/system/platform_d3d11.h>
-#include "scene_app.h"
-
-unsigned int sceLibcHeapSize = 128*1024*1024;	// Sets up the heap area size as 128MiB.
-
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR pScmdline, int iCmdshow)
-{
-	// initialisation
-	gef::PlatformD3D11 platform(hInstance, 960, 544, false, true);
-
-	SceneApp myApp(platform);
-	myApp.Run();
-
-	return 0;
+#include <platform/d3d11/system/platform_d3d11.h>
+#include "scene_app.h"
+#include <cstring>
+
+unsigned int sceLibcHeapSize = 128*1024*1024;	// Sets up the heap area size as 128MiB.
+
+// copies the word following name on the command line into value
+static bool GetArgument(const char* command_line, const char* name, char* value, size_t value_size)
+{
+	const char* argument = strstr(command_line, name);
+	if (!argument)
+		return false;
+
+	argument += strlen(name);
+	while (*argument == ' ')
+		argument++;
+
+	size_t length = 0;
+	while (argument[length] && argument[length] != ' ' && length + 1 < value_size)
+	{
+		value[length] = argument[length];
+		length++;
+	}
+	value[length] = '\0';
+
+	return length > 0;
+}
+
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR pScmdline, int iCmdshow)
+{
+	// initialisation
+	gef::PlatformD3D11 platform(hInstance, 960, 544, false, true);
+
+	SceneApp myApp(platform);
+
+	// "-record <file>" or "-replay <file>" for repeatable benchmark runs
+	char filename[MAX_PATH];
+	if (GetArgument(pScmdline, "-replay", filename, sizeof(filename)))
+		myApp.ReplayInput(filename);
+	else if (GetArgument(pScmdline, "-record", filename, sizeof(filename)))
+		myApp.RecordInput(filename);
+
+	if (strstr(pScmdline, "-raycast-bullets"))
+		myApp.UseRaycastBullets(true);
+
+	if (strstr(pScmdline, "-wall-bodies"))
+		myApp.UseWallBodies(true);
+
+	// "-memory-report <file>" writes the per tag totals on exit, "-show-memory" puts them on the HUD
+	if (GetArgument(pScmdline, "-memory-report", filename, sizeof(filename)))
+		myApp.ReportMemory(filename);
+	if (strstr(pScmdline, "-show-memory"))
+		myApp.ShowMemory(true);
+
+	if (strstr(pScmdline, "-software-render"))
+		myApp.UseSoftwareRenderer(true);
+
+	if (strstr(pScmdline, "-null-audio"))
+		myApp.UseNullAudio(true);
+
+	// "-software-audio" mixes on the CPU, "-audio-capture <file>" does too and saves the mix
+	if (GetArgument(pScmdline, "-audio-capture", filename, sizeof(filename)))
+		myApp.CaptureAudio(filename);
+	else if (strstr(pScmdline, "-software-audio"))
+		myApp.UseSoftwareAudio(true);
+
+	myApp.Run();
+
+	return 0;
 }
\ No newline at end of file
@@ -1,15 +1,15 @@
-#include <platform/vita/system/platform_vita.h>
-#include "scene_app.h"
-
-unsigned int sceLibcHeapSize = 128*1024*1024;	// Sets up the heap area size as 128MiB.
-
-int main(void)
-{
-	// initialisation
-	gef::PlatformVita platform;
-
-	SceneApp myApp(platform);
-	myApp.Run();
-
-	return 0;
+#include <platform/vita/system/platform_vita.h>
+#include "scene_app.h"
+
+unsigned int sceLibcHeapSize = 128*1024*1024;	// Sets up the heap area size as 128MiB.
+
+int main(void)
+{
+	// initialisation
+	gef::PlatformVita platform;
+
+	SceneApp myApp(platform);
+	myApp.Run();
+
+	return 0;
 }
\ No newline at end of file
@@ -1,1187 +1,2160 @@
-#include "scene_app.h"
-#include <system/platform.h>
-#include <graphics/sprite_renderer.h>
-#include <graphics/font.h>
-#include <system/debug_log.h>
-#include <graphics/renderer_3d.h>
-#include <graphics/mesh.h>
-#include <maths/math_utils.h>
-#include <input/sony_controller_input_manager.h>
-#include <graphics/sprite.h>
-//#include "load_texture.h"
-
-// constructor 
-SceneApp::SceneApp(gef::Platform& platform) :
-	Application(platform),
-	sprite_renderer_(NULL),
-	renderer_3d_(NULL),
-	primitive_builder_(NULL),
-	input_manager_(NULL),
-	font_(NULL),
-	world_(NULL),
-	game_state_(GameState_::Init),
-	state_timer(0.0f),
-	audio_manager_(NULL),
-	selected(0),
-	difficulty(0),
-	quitOut(false)
-{
-}
-
-// initialise
-void SceneApp::Init()
-{
-	sprite_renderer_ = gef::SpriteRenderer::Create(platform_);
-	InitFont();
-	
-
-	// initialise input manager
-	input_manager_ = gef::InputManager::Create(platform_);
-
-	audio_manager_ = gef::AudioManager::Create();
-
-	FrontendInit();
-	//GameInit();
-	
-	float musicVolume = 70.0f;
-	audio_manager_->SetMasterVolume(musicVolume);
-	audio_manager_->LoadMusic("pianoloop.wav", platform_);
-	audio_manager_->LoadSample("enemy.wav", platform_); //0
-	audio_manager_->LoadSample("Chicken_plop.wav", platform_); //1
-	audio_manager_->LoadSample("Chicken_hurt1.wav", platform_); //2
-	audio_manager_->PlayMusic();
-
-	game_state_ = GameState_::Init;
-	state_timer = 0.0f;
-}
-
-// delete
-void SceneApp::CleanUp()
-{
-	delete input_manager_;
-	input_manager_ = NULL;
-
-	CleanUpFont();
-
-	delete sprite_renderer_;
-	sprite_renderer_ = NULL;
-}
-
-// update sceneapp
-bool SceneApp::Update(float frame_time) // switch
-{
-	fps_ = 1.0f / frame_time;
-
-	state_timer += frame_time;
-
-	input_manager_->Update();
-
-	// gamestates
-	switch (game_state_)
-	{
-	case GameState_::Init:
-		InitStateUpdate(frame_time);
-		break;
-	case GameState_::Menu:
-		MenuUpdate(frame_time);
-		break;
-
-	case GameState_::Level1:
-		GameStateUpdate(frame_time);
-		break;
-
-	case GameState_::Setting:
-		// update settings
-		SettingsUpdate(frame_time);
-		break;
-
-	case GameState_::OVER:
-		// update settings
-		OverUpdate(frame_time);
-		break;
-
-	case GameState_::Exit:
-		
-		break; // quit game
-
-	default:
-		break;
-
-	}
-
-	if (!quitOut)
-	{
-		return true;
-	}
-	else if (quitOut)
-	{
-		return false;
-	}
-	
-}
-
-
-// sceneapp render
-void SceneApp::Render() /// switch
-{
-
-	// state switch
-	switch (game_state_)
-	{
-	case GameState_::Init:
-		InitStateRender();
-		break;
-
-	case GameState_::Menu:
-		MenuRender();
-		break;
-
-	case GameState_::Level1:
-		GameStateRender();
-		break;
-
-	case GameState_::Setting:
-		// render settings
-		SettingsRender();
-		break;
-
-	case GameState_::OVER:
-		// update settings
-		OverRender();
-		break;
-
-	case GameState_::Exit:
-		break; // quit game
-
-	default:
-		break;
-
-	}
-}
-
-
-
-// init the ground / base of the level, perhaps could have own class later
-void SceneApp::InitGround()
-{
-
-	wallOne.initWall(gef::Vector4(35.0f, 1.0f, 0.5f), gef::Vector4(0.f, 26.f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
-	wallTwo.initWall(gef::Vector4(1.0f, 27.0f, 0.5f), gef::Vector4(-36.f, 0.0f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
-	wallThree.initWall(gef::Vector4(35.0f, 1.0f, 0.5f), gef::Vector4(0.f, -26.f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
-	wallFour.initWall(gef::Vector4(1.0f, 27.0f, 0.5f), gef::Vector4(36.f, 0.0f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
-	/*wallOne.set_type(WALL);
-	wallTwo.set_type(WALL);
-	wallThree.set_type(WALL);
-	wallFour.set_type(WALL);*/
-
-	// ground dimensions
-	gef::Vector4 ground_half_dimensions(35.0f, 25.0f, 0.5f);
-	//gef::Vector4 wall_half_dimensions(35.0f, 1.0f, 0.5f);
-
-	// setup the mesh for the ground
-	ground_mesh_ = primitive_builder_->CreateBoxMesh(ground_half_dimensions);
-	ground_.set_mesh(ground_mesh_);
-
-	// create a physics body
-	b2BodyDef body_def; // collider information
-	body_def.type = b2_staticBody;
-	body_def.position = b2Vec2(0.0f, 0.0f);
-
-
-	ground_body_ = world_->CreateBody(&body_def);
-
-	// create the shape
-	b2PolygonShape shape;
-	shape.SetAsBox(ground_half_dimensions.x(), ground_half_dimensions.y());
-
-
-	// create the fixture
-	b2FixtureDef fixture_def;
-	fixture_def.shape = &shape;
-
-	// create the fixture on the rigid body
-	ground_body_->CreateFixture(&fixture_def);
-
-	// update visuals from simulation data
-	ground_.UpdateFromSimulation(ground_body_);
-
-	gef::Matrix44 translationMatrix;
-	translationMatrix.SetIdentity();
-	translationMatrix.SetTranslation(gef::Vector4(0, 0, -1));
-	ground_.set_transform(ground_.transform() * translationMatrix);
-
-
-	ground_body_->SetEnabled(false);
-	
-
-}
-
-// front end things
-void SceneApp::InitFont()
-{
-	font_ = new gef::Font(platform_);
-	font_->Load("comic_sans");
-}
-
-void SceneApp::CleanUpFont()
-{
-	delete font_;
-	font_ = NULL;
-}
-
-// hud
-void SceneApp::DrawHUD()
-{
-	if(font_)
-	{
-		// display frame rate
-		font_->RenderText(sprite_renderer_, gef::Vector4(850.0f, 510.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "FPS: %.1f", fps_);
-	}
-}
-
-void SceneApp::SetupLights()
-{
-	// grab the data for the default shader used for rendering 3D geometry
-	gef::Default3DShaderData& default_shader_data = renderer_3d_->default_shader_data();
-
-	// set the ambient light
-	default_shader_data.set_ambient_light_colour(gef::Colour(0.50f, 0.25f, 0.25f, 1.0f));
-
-	// add a point light that is almost white, but with a blue tinge
-	// the position of the light is set far away so it acts light a directional light
-	gef::PointLight default_point_light;
-	default_point_light.set_colour(gef::Colour(0.9f, 0.9f, 0.9f, 1.0f));
-	default_point_light.set_position(gef::Vector4(-300.0f, 400.0f, 700.0f));
-	default_shader_data.AddPointLight(default_point_light);
-} // lights
-
-// update physics sim
-void SceneApp::UpdateSimulation(float frame_time)
-{
-
-	// update physics world
-	float timeStep = 1.0f / 60.0f;
-
-	int32 velocityIterations = 6;
-	int32 positionIterations = 2;
-
-	world_->Step(timeStep, velocityIterations, positionIterations);
-
-	// don't have to update the ground visuals as it is static
-
-	// collision detection
-	// get the head of the contact list
-	b2Contact* contact = world_->GetContactList();
-	// get contact count
-	int contact_count = world_->GetContactCount();
-
-	for (int contact_num = 0; contact_num<contact_count; ++contact_num)
-	{
-		if (contact->IsTouching())
-		{
-			// get the colliding bodies
-			b2Body* bodyA = contact->GetFixtureA()->GetBody();
-			b2Body* bodyB = contact->GetFixtureB()->GetBody();
-
-			// COLLISION RESPONSE HERE
-			PlayerManager* player = NULL;
-			Enemy* enemy = NULL;
-			Bullet* bullet = NULL;
-			Walls* wall = NULL;
-
-			GameObject* gameObjectA = NULL;
-			GameObject* gameObjectB = NULL;
-
-			gameObjectA = reinterpret_cast<GameObject*>(bodyA->GetUserData().pointer);
-			gameObjectB = reinterpret_cast<GameObject*>(bodyB->GetUserData().pointer);
-
-			if (gameObjectA)
-			{
-
-				if (gameObjectA->type() == BULLET)
-				{
-					bullet = reinterpret_cast<Bullet*>(bodyA->GetUserData().pointer);
-				}
-
-				if (gameObjectA->type() == ENEMY)
-				{
-					enemy = reinterpret_cast<Enemy*>(bodyA->GetUserData().pointer);
-				}
-
-				if (gameObjectA->type() == PLAYER)
-				{
-					player = reinterpret_cast<PlayerManager*>(bodyA->GetUserData().pointer);
-				}
-
-				if (gameObjectA->type() == WALL)
-				{
-					wall = reinterpret_cast<Walls*>(bodyA->GetUserData().pointer);
-				}
-
-			}
-
-			if (gameObjectB)
-			{
-				if (gameObjectB->type() == BULLET)
-				{
-					bullet = reinterpret_cast<Bullet*>(bodyB->GetUserData().pointer);
-				}
-
-				if (gameObjectB->type() == ENEMY)
-				{
-					enemy = reinterpret_cast<Enemy*>(bodyB->GetUserData().pointer);
-				}
-
-				if (gameObjectB->type() == PLAYER)
-				{
-					player = reinterpret_cast<PlayerManager*>(bodyB->GetUserData().pointer);
-				}
-
-				if (gameObjectB->type() == WALL)
-				{
-					wall = reinterpret_cast<Walls*>(bodyB->GetUserData().pointer);
-				}
-
-			}
-
-			if (bullet && enemy)
-			{
-				enemy->setDead();
-				audio_manager_->PlaySample(0, false);
-				bullet->die();
-				audio_manager_->PlaySample(1, false);
-				player_one_->incScore();
-			}
-
-			if (player && enemy)
-			{
-				player->decrementLives();
-				//player_one_->decrementLives();
-				//gef::DebugOut("player coll");
-			}
-
-			if (bullet && wall)
-			{
-				audio_manager_->PlaySample(1, false);
-				bullet->die();
-			}
-
-			
-
-			
-		}
-
-		// Get next contact point
-		contact = contact->GetNext();
-	}
-} //collision
-
-// more front end stuff idk
-void SceneApp::FrontendInit()
-{
-	//button_icon_ = CreateTextureFromPNG("playstation-cross-dark-icon.png", platform_);
-	// splash
-	loader = modelLoader->CreateTextureFromPNG("loading.png", platform_);
-}
-
-void SceneApp::FrontendRelease()
-{
-	loader = NULL;
-}
-
-void SceneApp::FrontendUpdate(float frame_time)
-{
-	//const gef::SonyController* controller = input_manager_->controller_input()->GetController(0);
-}
-
-void SceneApp::FrontendRender()
-{
-	sprite_renderer_->Begin();
-
-	gef::Sprite background;
-	background.set_texture(loader);
-	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
-	background.set_height(platform_.height());
-	background.set_width(platform_.width());
-	sprite_renderer_->DrawSprite(background);
-
-
-	DrawHUD();
-	sprite_renderer_->End();
-}
-
-void SceneApp::MenuInit()
-{
-
-	main_menu = modelLoader->CreateTextureFromPNG("menu.png", platform_);
-
-}
-
-void SceneApp::MenuRelease()
-{
-
-	main_menu = NULL;
-}
-
-void SceneApp::MenuUpdate(float frame_time)
-{
-
-	const gef::Keyboard* keyboard = input_manager_->keyboard();
-
-	if (keyboard)
-	{
-		if (keyboard->IsKeyPressed(keyboard->KC_W))
-		{
-			audio_manager_->PlaySample(1, false);
-
-			if (selected > 0)
-			{
-				selected -= 1;
-			}
-			else
-			{
-				selected = 1;
-			}
-		}
-
-		if (keyboard->IsKeyPressed(keyboard->KC_S))
-		{
-			audio_manager_->PlaySample(1, false);
-
-			if (selected < 1)
-			{
-				selected += 1;
-			}
-			else
-			{
-				selected = 0;
-			}
-		}
-
-		if (keyboard->IsKeyPressed(keyboard->KC_SPACE))
-		{
-			audio_manager_->PlaySample(1, false);
-
-			if (selected == 0)
-			{
-				ChangeGameState(Setting);
-			}
-			else if (selected == 1)
-			{
-				ChangeGameState(Exit);
-				
-			}
-		}
-	}
-
-}
-
-void SceneApp::MenuRender()
-{
-
-	sprite_renderer_->Begin();
-
-	gef::Sprite background;
-	background.set_texture(main_menu);
-	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
-	background.set_height(platform_.height());
-	background.set_width(platform_.width());
-	sprite_renderer_->DrawSprite(background);
-
-	// render buttons
-
-	if (selected == 0)
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.5f - 56.0f, -0.99f),
-
-			1.2f,
-
-			0xff0000FF,
-
-			gef::TJ_LEFT,
-
-			"start");
-	}
-	else
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.5f - 56.0f, -0.99f),
-
-			1.0f,
-
-			0xffffffff,
-
-			gef::TJ_LEFT,
-
-			"start");
-	}
-
-	if (selected == 1)
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.7f - 56.0f, -0.99f),
-
-			1.2f,
-
-			0xff0000FF,
-
-			gef::TJ_LEFT,
-
-			"quit");
-	}
-	else
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.7f - 56.0f, -0.99f),
-
-			1.0f,
-
-			0xffffffff,
-
-			gef::TJ_LEFT,
-
-			"quit");
-	}
-
-	//DrawHUD();
-	sprite_renderer_->End();
-
-}
-
-void SceneApp::SettingsInit()
-{
-	difficulty = 0;
-	settings = modelLoader->CreateTextureFromPNG("settings.png", platform_);
-
-}
-
-void SceneApp::SettingsRelease()
-{
-
-	settings = NULL;
-
-}
-
-void SceneApp::SettingsUpdate(float frame_time)
-{
-
-	const gef::Keyboard* keyboard = input_manager_->keyboard();
-
-	if (keyboard)
-	{
-
-		if (keyboard->IsKeyPressed(keyboard->KC_W))
-		{
-			audio_manager_->PlaySample(1, false);
-
-			if (selected > 0)
-			{
-				selected -= 1;
-			}
-			else
-			{
-				selected = 1;
-			}
-		}
-
-		if (keyboard->IsKeyPressed(keyboard->KC_S))
-		{
-			audio_manager_->PlaySample(1, false);
-
-			if (selected < 1)
-			{
-				selected += 1;
-			}
-			else
-			{
-				selected = 0;
-			}
-		}
-
-		if (keyboard->IsKeyPressed(keyboard->KC_SPACE))
-		{
-			audio_manager_->PlaySample(1, false);
-
-			if (selected == 0)
-			{
-				//ChangeGameState(Setting);
-				// easy difficulty
-				difficulty = 1;
-				ChangeGameState(Level1);
-			}
-			else if (selected == 1)
-			{
-				//ChangeGameState(Exit);
-				// hard difficulty
-				difficulty = 1;
-				ChangeGameState(Level1);
-
-			}
-		}
-	}
-
-}
-
-void SceneApp::SettingsRender()
-{
-
-	sprite_renderer_->Begin();
-
-	gef::Sprite background;
-	background.set_texture(settings);
-	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
-	background.set_height(platform_.height());
-	background.set_width(platform_.width());
-	sprite_renderer_->DrawSprite(background);
-
-	// render buttons
-
-	if (selected == 0)
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.35f - 56.0f, -0.99f),
-
-			1.2f,
-
-			0xff0000FF,
-
-			gef::TJ_LEFT,
-
-			"easy");
-	}
-	else
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.35f - 56.0f, -0.99f),
-
-			1.0f,
-
-			0xffffffff,
-
-			gef::TJ_LEFT,
-
-			"easy");
-	}
-
-	if (selected == 1)
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.45f - 56.0f, -0.99f),
-
-			1.2f,
-
-			0xff0000FF,
-
-			gef::TJ_LEFT,
-
-			"hard");
-	}
-	else
-	{
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.45f - 56.0f, -0.99f),
-
-			1.0f,
-
-			0xffffffff,
-
-			gef::TJ_LEFT,
-
-			"hard");
-	}
-
-	//DrawHUD();
-	sprite_renderer_->End();
-
-}
-
-void SceneApp::OverInit()
-{
-	//get player score
-	endscreen = modelLoader->CreateTextureFromPNG("gameover.png", platform_);
-
-}
-
-void SceneApp::OverRelease()
-{
-	endscreen = NULL;
-}
-
-void SceneApp::OverUpdate(float frame_time)
-{
-	const gef::Keyboard* keyboard = input_manager_->keyboard();
-
-	if (keyboard)
-	{
-		if (keyboard->IsKeyPressed(keyboard->KC_SPACE))
-		{
-				//ChangeGameState(Setting);
-				// easy difficulty
-				difficulty = 1;
-				ChangeGameState(Menu);
-		}
-	}
-}
-
-void SceneApp::OverRender()
-{
-	sprite_renderer_->Begin();
-
-	gef::Sprite background;
-	background.set_texture(endscreen);
-	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
-	background.set_height(platform_.height());
-	background.set_width(platform_.width());
-	sprite_renderer_->DrawSprite(background);
-
-	// render buttons
-
-	std::string str;
-	str.append("Final Score: ");
-	str.append(std::to_string(finalScore)); // gets the score as int)
-	char const* pchar = str.c_str(); // casts it to a const char
-
-		font_->RenderText(
-			sprite_renderer_,
-
-			gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.45f - 56.0f, -0.99f),
-
-			1.2f,
-
-			0xff0000FF,
-
-			gef::TJ_LEFT,
-
-			pchar);
-	
-
-	
-	//DrawHUD();
-	sprite_renderer_->End();
-
-
-}
-
-// game init
-void SceneApp::GameInit()
-{
-	gef::Colour colour_;
-	colour_.SetFromRGBA(0x0c0c0a00);
-	platform_.set_render_target_clear_colour(colour_);
-
-
-	// create the renderer for draw 3D geometry
-	renderer_3d_ = gef::Renderer3D::Create(platform_);
-
-	// initialise primitive builder to make create some 3D geometry easier
-	primitive_builder_ = new PrimitiveBuilder(platform_);
-
-	SetupLights();
-
-	// initialise the physics world
-	b2Vec2 gravity(0.0f, 0.0f);
-	world_ = new b2World(gravity);
-
-	//InitPlayer();
-	//player_one_->InitPlayer();
-	player_one_ = new PlayerManager(primitive_builder_, world_, renderer_3d_, &platform_);
-	player_one_->InitPlayer();
-
-	// initialise enemy manager
-	enemy_manager_ = new EnemyManager(world_, sprite_renderer_, renderer_3d_, primitive_builder_, &platform_, difficulty);
-	enemy_manager_->InitEnemies();
-
-	playerBullets_ = new BulletManager(world_, sprite_renderer_, renderer_3d_, primitive_builder_);
-	playerBullets_->InitBullets();
-
-
-	InitGround();
-	initOcean();
-}
-
-// delete
-void SceneApp::GameRelease()
-{
-	// destroying the physics world also destroys all the objects within it
-	delete world_;
-	world_ = NULL;
-
-	delete ground_mesh_;
-	ground_mesh_ = NULL;
-
-	delete primitive_builder_;
-	primitive_builder_ = NULL;
-
-	delete renderer_3d_;
-	renderer_3d_ = NULL;
-
-	delete player_one_;
-	delete playerBullets_;
-	delete enemy_manager_;
-
-	//modelLoader = NULL;
-
-
-}
-
-// game update
-void SceneApp::GameUpdate(float frame_time)
-{
-	const gef::SonyController* controller = input_manager_->controller_input()->GetController(0);
-
-	//audio_manager_->PlayMusic();
-
-	if (!player_one_->playerStatus()) // while the player is still alive
-	{
-
-		//input_manager_->keyboard()->Update();
-		playerBullets_->CreateNew(input_manager_, player_one_->player_body_->GetPosition(), frame_time);
-
-		player_one_->MovePlayer(frame_time, input_manager_); //update physics
-
-		enemy_manager_->CreateNew(frame_time);
-
-		UpdateSimulation(frame_time); // UPDATES PHYSICS
-
-		//update player sim
-		player_one_->Update(frame_time);
-
-		if (!player_one_->playerStatus()) // while the player is still alive
-		{
-			// update enemies
-			enemy_manager_->Update(frame_time, player_one_->player_body_->GetPosition());
-		}
-		
-		// update bullets
-		playerBullets_->Update(frame_time);
-	}
-	else if (player_one_->playerStatus())
-	{
-		finalScore = player_one_->getScore();
-		ChangeGameState(OVER);
-	}
-	
-
-}
-
-// game render, camera etc
-void SceneApp::GameRender()
-{
-	// setup camera
-
-	// projection
-	float fov = gef::DegToRad(45.0f);
-	float aspect_ratio = (float)platform_.width() / (float)platform_.height();
-	gef::Matrix44 projection_matrix;
-	projection_matrix = platform_.PerspectiveProjectionFov(fov, aspect_ratio, 0.1f, 100.0f);
-	renderer_3d_->set_projection_matrix(projection_matrix); 
-
-
-	// view
-	//gef::Vector4 camera_eye(0.0f, -10.0f, 70.0f); // pos of the camera in space (frustrum <3)
-	gef::Vector4 camera_eye(0.0f + player_one_->player_body_->GetPosition().x, -10.0f + player_one_->player_body_->GetPosition().y, 50.0f); // pos of the camera in space (frustrum <3)
-	gef::Vector4 camera_lookat(player_one_->player_body_->GetPosition().x, player_one_->player_body_->GetPosition().y, 0.0f); // what the camera is positioned to look at 
-	gef::Vector4 camera_up(0.0f, 1.0f, 0.0f); // up vector <3333
-	gef::Matrix44 view_matrix;
-	view_matrix.LookAt(camera_eye, camera_lookat, camera_up);
-	renderer_3d_->set_view_matrix(view_matrix);
-
-
-	// draw 3d geometry
-	renderer_3d_->Begin();
-
-	//renderer_3d_->set_override_material(mat);
-	renderer_3d_->DrawMesh(mesh_instance_);
-
-	// draw ground
-	renderer_3d_->set_override_material(pondtex);
-	renderer_3d_->DrawMesh(ground_);
-	renderer_3d_->set_override_material(NULL);
-
-
-	// draw wall
-	//renderer_3d_->DrawMesh(wall_);
-	wallOne.renderWall();
-	wallTwo.renderWall();
-	wallThree.renderWall();
-	wallFour.renderWall();
-
-	//// draw player
-	
-	player_one_->Render();
-
-	// draw Enemies
-	enemy_manager_->Render();
-
-	// draw bullets 
-	playerBullets_->Render();
-
-	renderer_3d_->End();
-
-	// start drawing sprites, but don't clear the frame buffer
-	sprite_renderer_->Begin(false);
-	DrawHUD();
-	sprite_renderer_->End();
-}
-
-// model loading
-
-//backgriound pond // initially waves but changed to pond model
-void SceneApp::initOcean()
-{
-	// load the assets in from the .scn
-	const char* scene_asset_filename = "pond.scn";
-	scene_assets_ = modelLoader->LoadSceneAssets(platform_, scene_asset_filename);
-	if (scene_assets_)
-	{
-		mesh_instance_.set_mesh(modelLoader->GetMeshFromSceneAssets(scene_assets_));
-	}
-	else
-	{
-		gef::DebugOut("Scene file %s failed to load\n", scene_asset_filename);
-	}
-
-	
-	gef::Matrix44 rotation_;
-	rotation_.SetIdentity();
-	rotation_.RotationX(gef::DegToRad(90));
-	//mesh_instance_.set_transform(mesh_instance_.transform() * rotation_);
-
-
-	gef::Matrix44 translate_;
-	translate_.SetIdentity();
-	translate_.Scale(gef::Vector4(50, 50, 0));
-	translate_.SetTranslation(gef::Vector4(0, 0, -50));
-
-	mesh_instance_.set_transform(rotation_ * translate_);
-
-	gef::Texture* texture;
-	texture = modelLoader->CreateTextureFromPNG("pixelwatertrans.png", platform_);
-
-	pondtex = new gef::Material();
-	//pondtex->set_colour();
-	pondtex->set_texture(texture);
-
-	
-	
-}
-
-
-///////////////////////////////////////////////////// game states //////////////////////////////////////////////////////
-
-
-void SceneApp::InitStateUpdate(float frame_time)
-{
-	
-	// splash screen
-
-	if (state_timer > 4.0f)
-	{
-		ChangeGameState(GameState_::Menu);
-	}
-}
-
-void SceneApp::InitStateRender()
-{
-	
-	// splash
-	FrontendRender();
-
-}
-
-//void SceneApp::MenuStateUpdate(float frame_time)
-//{
-//	//update menu
-//
-//}
-//
-//void SceneApp::MenuStateRender()
-//{
-//
-//	// render menu
-//
-//	sprite_renderer_->Begin();
-//
-//	// render "TO START" text
-//	font_->RenderText(
-//		sprite_renderer_,
-//		gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f + 32.0f, -0.99f),
-//		1.0f,
-//		0xffffffff,
-//		gef::TJ_CENTRE,
-//		"MENU");
-//
-//
-//	DrawHUD();
-//	sprite_renderer_->End();
-//}
-
-void SceneApp::GameStateInit()
-{
-
-	GameInit();
-
-}
-
-void SceneApp::GameStateUpdate(float frame_time)
-{
-
-	GameUpdate(frame_time);
-
-}
-
-void SceneApp::GameStateRender()
-{
-	sprite_renderer_->Begin();
-
-	renderer_3d_->Begin();
-
-	GameRender();
-
-	std::string str;
-	str.append("Score: ");
-	str.append(std::to_string(player_one_->getScore())); // gets the score as int)
-	char const* pchar = str.c_str(); // casts it to a const char
-
-	std::string Lstr;
-	Lstr.append("Lives Left: ");
-	Lstr.append(std::to_string(player_one_->playerLiveCount())); // gets the score as int)
-	char const* Lchar = Lstr.c_str(); // casts it to a const char
-
-	// render "life and score " text
-	font_->RenderText(
-		sprite_renderer_,
-
-		gef::Vector4(platform_.width() * 0.02f, platform_.height() * 0.04f + 32.0f, -0.99f),
-
-		1.0f,
-
-		0xff0000FF,
-
-		gef::TJ_LEFT,
-
-		pchar);
-
-	font_->RenderText(
-		sprite_renderer_,
-
-		gef::Vector4(platform_.width() * 0.02f, platform_.height() * 0.08f + 32.0f, -0.99f),
-
-		1.0f,
-
-		0xff0000FF,
-
-		gef::TJ_LEFT,
-
-		Lchar);
-
-
-
-
-	DrawHUD();
-
-	renderer_3d_->End();
-
-	sprite_renderer_->End();
-
-
-}
-
-void SceneApp::GameStateRelease()
-{
-	GameRelease();
-}
-
-void SceneApp::ChangeGameState(GameState_ new_state)
-{
-
-	switch (game_state_)
-	{
-	case  GameState_::Init: // cleanupinit
-		FrontendRelease();
-		break;
-
-	case  GameState_::Menu:
-		MenuRelease();
-		break; // cleanup menu
-
-	case  GameState_::Level1:
-		GameRelease();
-		break; //cleanupmenu
-
-	case GameState_::Setting:
-		SettingsRelease();
-		break; // cleanup menu
-
-	default:
-		break;
-	}
-
-	switch (new_state)
-	{
-	case  GameState_::Init: 
-
-		FrontendInit();
-		// set up init
-		break;
-
-	case  GameState_::Menu:
-		MenuInit();
-		//FrontendInit();
-		game_state_ = Menu;
-		state_timer = 0;
-		break; // cleanup menu
-
-	case  GameState_::Level1:
-
-		GameInit();
-		game_state_ = Level1;
-		state_timer = 0;
-
-		break; //cleanuplevel
-
-	case GameState_::Setting:
-
-		SettingsInit();
-		game_state_ = Setting;
-		state_timer = 0;
-		break; // cleanup menu
-
-	case GameState_::OVER:
-
-		OverInit();
-		game_state_ = OVER;
-		state_timer = 0;
-		break; // cleanup menu
-
-	case GameState_::Exit:
-		quitOut = true;
-		break;
-
-	default:
-		break;
-	}
-
-	//clean up old state
-	//game_state_ = new_state;
-	//state_timer = 0;
-
-	// init new state
-}
+#include "scene_app.h"
+#include <system/platform.h>
+#include <graphics/sprite_renderer.h>
+#include <graphics/font.h>
+#include <system/debug_log.h>
+#include <graphics/renderer_3d.h>
+#include <graphics/mesh.h>
+#include <maths/math_utils.h>
+#include <input/sony_controller_input_manager.h>
+#include <graphics/sprite.h>
+#include <ctime>
+#include <chrono>
+#include <algorithm>
+//#include "load_texture.h"
+
+// what the settings screen hands EnemyManager, difficulty is 0 until a choice is made
+static const int kDifficultyEasy = 1;
+static const int kDifficultyHard = 2;
+
+// inside edges of the arena walls
+static const float kArenaHalfWidth = 35.0f;
+static const float kArenaHalfHeight = 25.0f;
+
+// enemies closer than this get pushed apart before the physics step
+static const float kSeparationRadius = 2.0f;
+static const float kSeparationStrength = 3.0f;
+
+// resolution of the flow field enemies follow to the player
+static const float kFlowCellSize = 1.0f;
+
+// how fast enemies follow the field, easy ones slowly. EnemyManager's own speed can't be
+// read back, and the body's velocity already has the last separation push in it
+static const float kEnemySpeedEasy = 4.0f;
+static const float kEnemySpeedHard = 6.0f;
+
+// enemies per job when steering is split across threads
+static const int kSteeringGrain = 256;
+
+// most ray cast bullets alive at once
+static const int kMaxProjectiles = 16384;
+
+// how far inside the arena edge the player and enemies are held
+static const float kPlayerEdgeMargin = 1.0f;
+static const float kEnemyEdgeMargin = 1.0f;
+
+// size of the buckets lights are sorted into
+static const float kLightCellSize = 10.0f;
+
+// static screens drop to the idle rate once nothing has changed for kScreenActiveTime.
+// the idle rate still has to poll often enough to catch a quick key tap
+static const float kActiveFrameInterval = 1.0f / 60.0f;
+static const float kIdleFrameInterval = 1.0f / 20.0f;
+static const float kScreenActiveTime = 0.5f;
+
+// flat colours for the software renderer, it has no textures
+static const UInt32 kSoftwareClearColour = 0xff0a0c0c;
+static const UInt32 kSoftwarePondColour = 0xff804020;
+static const UInt32 kSoftwareGroundColour = 0xffa06030;
+static const UInt32 kSoftwareBulletColour = 0xff00ffff;
+
+static UInt32 SoftwareColour(OBJECT_TYPE type)
+{
+	switch (type)
+	{
+	case PLAYER:
+		return 0xff00d0ff;
+	case ENEMY:
+		return 0xff2020e0;
+	case BULLET:
+		return kSoftwareBulletColour;
+	default:
+		return 0xff808080;
+	}
+}
+
+// true on the frame any key the game uses goes down or comes up
+static bool KeyStateChanged(const gef::Keyboard* keyboard)
+{
+	if (!keyboard)
+		return false;
+
+	for (int key_num = 0; key_num < kNumRecordedKeys; ++key_num)
+	{
+		if (keyboard->IsKeyPressed(kRecordedKeys[key_num]) || keyboard->IsKeyReleased(kRecordedKeys[key_num]))
+			return true;
+	}
+
+	return false;
+}
+
+// a snapshot every 6 frames and 120 of them, so about 12 seconds of rewind at 60fps
+static const int kSnapshotInterval = 6;
+static const int kSnapshotCount = 120;
+
+// sound effects in load order, with how much of the voice pool each may have. kills
+// outrank the bullet plops, which there can be dozens of in one step
+static const int kSoundEnemy = 0;
+static const int kSoundPlop = 1;
+static const int kSoundHurt = 2;
+static const int kNumSounds = 3;
+
+static const char* kMusicFile = "pianoloop.wav";
+static const float kMusicVolume = 0.7f;
+
+static const char* kSoundFiles[kNumSounds] = { "enemy.wav", "Chicken_plop.wav", "Chicken_hurt1.wav" };
+
+// the bank's copies for -software-audio and -null-audio, IMA ADPCM made by
+// tools/adpcm_convert at a quarter of the size to read
+static const char* kSoundBankFiles[kNumSounds] = { "enemy.adp", "Chicken_plop.adp", "Chicken_hurt1.adp" };
+static const SampleLimits kSoundLimits[kNumSounds] =
+{
+	{ 4, 0.03f, 2 },
+	{ 3, 0.05f, 1 },
+	{ 2, 0.1f, 3 }
+};
+
+// the wavs' lengths, 16 bit stereo at 44.1kHz. gef plays its own copies and has no way to
+// say how long they are, so the pool times its voices from these rather than reading
+// the files again. tools/adpcm_convert prints them, keep them in step if a wav changes
+static const UInt32 kSoundFrames[kNumSounds] = { 27958, 8384, 25280 };
+static const UInt16 kSoundChannels = 2;
+static const UInt32 kSoundRate = 44100;
+
+// the simulation runs in steps of this, as many a frame as the frame time covers up
+// to kMaxSubsteps, past which the game slows down rather than spiralling
+static const float kFixedStep = 1.0f / 60.0f;
+static const int kMaxSubsteps = 4;
+
+// room for the level's meshes and scene data with the managers of one play-through on
+// top, anything past this falls back to the heap
+static const size_t kLevelArenaSize = 2 * 1024 * 1024;
+
+// room the per step body gathers get up front in the arena, more than that goes to the heap
+static const int kMaxGatheredBodies = 256;
+
+// gives a vector's storage back, for ones holding arena memory before the arena goes
+template<typename T>
+static void ReleaseVector(std::vector<T>& vector)
+{
+	std::vector<T>().swap(vector);
+}
+
+// indexed by GameState_, so in the same order
+const SceneApp::GameStateInfo SceneApp::kGameStates[NUM_GAME_STATES] =
+{
+	{ "Init", &SceneApp::FrontendInit, &SceneApp::FrontendRelease, &SceneApp::InitStateUpdate, &SceneApp::InitStateRender, "loading.png", NULL, GameState_::Menu },
+	{ "Menu", &SceneApp::MenuInit, &SceneApp::MenuRelease, &SceneApp::MenuUpdate, &SceneApp::MenuRender, "menu.png", NULL, GameState_::Setting },
+	{ "Level1", &SceneApp::GameStateInit, &SceneApp::GameStateRelease, &SceneApp::GameStateUpdate, &SceneApp::GameStateRender, "pixelwatertrans.png", "pond.scn", GameState_::OVER },
+	{ "Exit", &SceneApp::ExitInit, NULL, NULL, NULL, NULL, NULL, GameState_::Exit },
+	{ "Setting", &SceneApp::SettingsInit, &SceneApp::SettingsRelease, &SceneApp::SettingsUpdate, &SceneApp::SettingsRender, "settings.png", NULL, GameState_::Level1 },
+	{ "OVER", &SceneApp::OverInit, &SceneApp::OverRelease, &SceneApp::OverUpdate, &SceneApp::OverRender, "gameover.png", NULL, GameState_::Menu }
+};
+
+// constructor 
+SceneApp::SceneApp(gef::Platform& platform) :
+	Application(platform),
+	sprite_renderer_(NULL),
+	renderer_3d_(NULL),
+	primitive_builder_(NULL),
+	input_manager_(NULL),
+	platform_input_manager_(NULL),
+	scripted_input_(NULL),
+	rng_seed_(0),
+	contact_count_(0),
+	touching_count_(0),
+	step_time_ms_(0.0f),
+	font_(NULL),
+	world_(NULL),
+	player_one_(NULL),
+	enemy_manager_(NULL),
+	playerBullets_(NULL),
+	ground_mesh_(NULL),
+	scene_assets_(NULL),
+	pondtex(NULL),
+	level_arena_mark_(0),
+	pond_texture_(NULL),
+	level_loaded_(false),
+	game_state_(GameState_::Init),
+	state_timer(0.0f),
+	asset_preloader_(platform),
+	last_transition_from_(GameState_::Init),
+	audio_manager_(NULL),
+	job_system_(NULL),
+	software_renderer_(NULL),
+	render_job_system_(NULL),
+	render_thread_(NULL),
+	render_frame_(0),
+	use_software_renderer_(false),
+	raycast_bullets_(false),
+	analytic_bounds_(true),
+	selected(0),
+	difficulty(0),
+	show_memory_(false),
+	step_input_(NULL),
+	async_input_(false),
+	step_keys_(0),
+	frame_keys_(0),
+	step_accumulator_(0.0f),
+	null_audio_(false),
+	software_audio_(false),
+	screen_active_time_(kScreenActiveTime),
+	screen_dirty_(true),
+	quitOut(false)
+{
+	for (int i = 0; i < kNumDifficulties; ++i)
+	{
+		level_arena_peak_[i] = 0;
+	}
+
+	for (int from = 0; from < NUM_GAME_STATES; ++from)
+	{
+		for (int to = 0; to < NUM_GAME_STATES; ++to)
+		{
+			transitions_[from][to].count = 0;
+			transitions_[from][to].last_ms = 0.0f;
+			transitions_[from][to].max_ms = 0.0f;
+		}
+	}
+}
+
+// initialise
+void SceneApp::Init()
+{
+	{
+		MemoryTagScope ui_tag(MEMORY_TAG_UI);
+		sprite_renderer_ = gef::SpriteRenderer::Create(platform_);
+		InitFont();
+	}
+	
+
+	// initialise input manager
+	platform_input_manager_ = gef::InputManager::Create(platform_);
+	input_manager_ = platform_input_manager_;
+
+	// what the fixed steps read the keys from, set from the event queue before each one
+	step_input_ = new ScriptedInputManager(platform_, platform_input_manager_);
+
+	// one seed per session, replays reuse the recorded one so runs are identical
+	rng_seed_ = (UInt32)time(NULL);
+
+	if (!replay_filename_.empty() && input_recorder_.LoadReplay(replay_filename_.c_str()))
+	{
+		scripted_input_ = new ScriptedInputManager(platform_, platform_input_manager_);
+		input_manager_ = scripted_input_;
+		rng_seed_ = input_recorder_.seed();
+	}
+	else if (!record_filename_.empty())
+	{
+		input_recorder_.StartRecording(record_filename_.c_str(), rng_seed_);
+	}
+
+	// keys are read on their own thread where that's possible, but recordings are per
+	// frame, so recording and replaying stay on the frame polled keys to match
+	async_input_ = !scripted_input_ && !input_recorder_.recording() && input_poller_.Start(&input_events_);
+
+	// EnemyManager still draws from rand(), keep it on the session seed too
+	srand(rng_seed_);
+
+	// one thread per core, the main thread included. the rasteriser runs alongside the
+	// next update, so with the software renderer the cores are split between the two
+	// pools rather than both asking for all of them
+	const int cores = std::max(1, (int)std::thread::hardware_concurrency());
+	const int render_threads = use_software_renderer_ ? std::max(1, cores / 2) : 0;
+	job_system_ = new JobSystem(std::max(1, cores - render_threads));
+
+	if (use_software_renderer_)
+	{
+		render_job_system_ = new JobSystem(render_threads);
+		software_renderer_ = new SoftwareRenderer(platform_.width(), platform_.height(), render_job_system_);
+		render_thread_ = new RenderThread(software_renderer_, &render_packets_);
+		render_thread_->Start();
+	}
+
+	asset_preloader_.Start();
+	EnterGameState(GameState_::Init);
+	//GameInit();
+	
+	{
+		MemoryTagScope audio_tag(MEMORY_TAG_AUDIO);
+
+		// the software mixer and the null output play from the bank's PCM, decoded from the
+		// ADPCM copies. gef loads each wav itself for OpenAL, so then the bank only holds
+		// the lengths to time voices and the .adp files aren't read
+		if (!null_audio_ && !software_audio_)
+		{
+			audio_manager_ = gef::AudioManager::Create();
+			gef_audio_output_.Init(audio_manager_);
+		}
+
+		for (int sound_num = 0; sound_num < kNumSounds; ++sound_num)
+		{
+			// the ADPCM falls back to the wav, and failing either an empty sample keeps the ids lined up
+			int sample = -1;
+			if (audio_manager_)
+			{
+				const Int32 gef_sample = audio_manager_->LoadSample(kSoundFiles[sound_num], platform_);
+				gef_audio_output_.AddSample(gef_sample);
+				if (gef_sample >= 0)
+				{
+					sample = sound_bank_.AddHeader(kSoundFiles[sound_num], kSoundFrames[sound_num], kSoundChannels, kSoundRate, kSoundLimits[sound_num]);
+				}
+			}
+			else if ((sample = sound_bank_.LoadAdpcm(kSoundBankFiles[sound_num], kSoundLimits[sound_num])) < 0)
+			{
+				sample = sound_bank_.LoadWav(kSoundFiles[sound_num], kSoundLimits[sound_num]);
+			}
+
+			if (sample < 0)
+			{
+				sound_bank_.AddSample(kSoundFiles[sound_num], NULL, 0, 1, SoftwareMixer::kOutputRate, kSoundLimits[sound_num]);
+			}
+		}
+
+		if (software_audio_)
+		{
+			// music streams from disk rather than being loaded whole
+			if (!audio_capture_filename_.empty() && audio_capture_.Open(audio_capture_filename_.c_str(), SoftwareMixer::kOutputRate))
+			{
+				software_mixer_.Init(&sound_bank_, &audio_capture_);
+			}
+			else
+			{
+				software_mixer_.Init(&sound_bank_, &null_audio_sink_);
+			}
+
+			if (music_stream_.Open(kMusicFile, true))
+			{
+				software_mixer_.set_music(&music_stream_, kMusicVolume);
+			}
+
+			sound_voices_.Init(&sound_bank_, &software_mixer_);
+		}
+		else if (null_audio_)
+		{
+			sound_voices_.Init(&sound_bank_, &null_audio_output_);
+		}
+		else
+		{
+			sound_voices_.Init(&sound_bank_, &gef_audio_output_);
+		}
+
+		if (audio_manager_)
+		{
+			float musicVolume = 70.0f;
+			audio_manager_->SetMasterVolume(musicVolume);
+			audio_manager_->LoadMusic(kMusicFile, platform_);
+			audio_manager_->PlayMusic();
+		}
+	}
+}
+
+// delete
+void SceneApp::CleanUp()
+{
+	input_recorder_.StopRecording();
+
+	const GameStateInfo& state = kGameStates[game_state_];
+	if (state.exit)
+	{
+		(this->*state.exit)();
+	}
+
+	for (int from = 0; from < NUM_GAME_STATES; ++from)
+	{
+		for (int to = 0; to < NUM_GAME_STATES; ++to)
+		{
+			const GameStateTransition& transition = transitions_[from][to];
+			if (transition.count > 0)
+			{
+				gef::DebugOut("State change %s -> %s: %u times, last %.2fms, max %.2fms\n",
+					kGameStates[from].name, kGameStates[to].name, transition.count, transition.last_ms, transition.max_ms);
+			}
+		}
+	}
+
+	// whatever was preloaded for a state that never came is dropped here
+	asset_preloader_.Stop();
+
+	LevelUnload();
+
+	input_poller_.Stop();
+
+	delete step_input_;
+	step_input_ = NULL;
+
+	delete scripted_input_;
+	scripted_input_ = NULL;
+
+	sound_voices_.StopAll();
+	sound_bank_.Clear();
+
+	if (software_audio_)
+	{
+		gef::DebugOut("Mixer: %u frames, %.2fus per voice per ms of output, audio peak %uKB, %u music underruns\n",
+			software_mixer_.frames_mixed(), software_mixer_.voice_us_per_ms(),
+			(UInt32)(MemoryTracker::Stats(MEMORY_TAG_AUDIO).peak_bytes / 1024), music_stream_.underruns());
+	}
+
+	music_stream_.Close();
+	audio_capture_.Close();
+
+	delete platform_input_manager_;
+	platform_input_manager_ = NULL;
+	input_manager_ = NULL;
+
+	CleanUpFont();
+
+	if (!memory_report_filename_.empty() && !MemoryTracker::Dump(memory_report_filename_.c_str()))
+	{
+		gef::DebugOut("Could not write memory report %s\n", memory_report_filename_.c_str());
+	}
+
+	// the render thread finishes what's queued before the renderer goes
+	delete render_thread_;
+	render_thread_ = NULL;
+
+	delete software_renderer_;
+	software_renderer_ = NULL;
+
+	delete render_job_system_;
+	render_job_system_ = NULL;
+
+	delete job_system_;
+	job_system_ = NULL;
+
+	delete sprite_renderer_;
+	sprite_renderer_ = NULL;
+}
+
+// update sceneapp
+bool SceneApp::Update(float frame_time)
+{
+	// the wait goes before input is read, so the sleep falls between the last Render and
+	// this frame's input rather than between the update and the Render that shows it
+	PaceFrame(frame_time);
+
+	input_manager_->Update();
+
+	if (input_recorder_.recording())
+	{
+		input_recorder_.RecordFrame(frame_time, input_manager_->keyboard());
+	}
+	else if (scripted_input_)
+	{
+		// replay the recorded frame time too so the run is identical
+		if (input_recorder_.ReplayFrame(scripted_input_->scripted_keyboard()))
+		{
+			frame_time = input_recorder_.frame_time();
+		}
+		else
+		{
+			gef::DebugOut("Replay finished after %u frames\n", input_recorder_.frame_count());
+			quitOut = true;
+		}
+	}
+
+	if (KeyStateChanged(input_manager_->keyboard()))
+	{
+		MarkScreenActive();
+	}
+
+	// without the poller thread the frame's key changes go through the queue instead,
+	// stamped to be taken by the first step that runs
+	if (!async_input_)
+	{
+		const UInt16 frame_keys = RecordedKeyBits(input_manager_->keyboard());
+		input_events_.PushChanges(frame_keys_, frame_keys, 0.0);
+		frame_keys_ = frame_keys;
+	}
+
+	fps_ = 1.0f / frame_time;
+
+	state_timer += frame_time;
+
+	const GameStateInfo& state = kGameStates[game_state_];
+	if (state.update)
+	{
+		(this->*state.update)(frame_time);
+	}
+
+	// nothing steps outside the game, keep the step keys current and the queue empty
+	if (game_state_ != GameState_::Level1)
+	{
+		input_events_.Flush(step_keys_);
+	}
+
+	sound_voices_.Update(frame_time);
+
+	MemoryTracker::EndFrame();
+
+	if (!quitOut)
+	{
+		return true;
+	}
+	else if (quitOut)
+	{
+		return false;
+	}
+	
+}
+
+
+void SceneApp::RecordInput(const char* filename)
+{
+	record_filename_ = filename;
+}
+
+void SceneApp::ReplayInput(const char* filename)
+{
+	replay_filename_ = filename;
+}
+
+// sceneapp render
+void SceneApp::Render()
+{
+	MemoryTagScope render_tag(MEMORY_TAG_RENDER);
+
+	const GameStateInfo& state = kGameStates[game_state_];
+	if (state.render)
+	{
+		(this->*state.render)();
+	}
+
+	// the frame is up to date with whatever marked it dirty
+	screen_dirty_ = false;
+}
+
+
+
+// init the ground / base of the level, perhaps could have own class later
+void SceneApp::InitGround()
+{
+
+	wallOne.initWall(gef::Vector4(35.0f, 1.0f, 0.5f), gef::Vector4(0.f, 26.f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
+	wallTwo.initWall(gef::Vector4(1.0f, 27.0f, 0.5f), gef::Vector4(-36.f, 0.0f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
+	wallThree.initWall(gef::Vector4(35.0f, 1.0f, 0.5f), gef::Vector4(0.f, -26.f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
+	wallFour.initWall(gef::Vector4(1.0f, 27.0f, 0.5f), gef::Vector4(36.f, 0.0f, 0.f), world_, sprite_renderer_, renderer_3d_, primitive_builder_);
+	/*wallOne.set_type(WALL);
+	wallTwo.set_type(WALL);
+	wallThree.set_type(WALL);
+	wallFour.set_type(WALL);*/
+
+	// ground dimensions
+	gef::Vector4 ground_half_dimensions(35.0f, 25.0f, 0.5f);
+	//gef::Vector4 wall_half_dimensions(35.0f, 1.0f, 0.5f);
+
+	// the mesh for the ground is made once in LevelLoad
+	ground_.set_mesh(ground_mesh_);
+
+	// create a physics body
+	b2BodyDef body_def; // collider information
+	body_def.type = b2_staticBody;
+	body_def.position = b2Vec2(0.0f, 0.0f);
+
+
+	ground_body_ = world_->CreateBody(&body_def);
+
+	// create the shape
+	b2PolygonShape shape;
+	shape.SetAsBox(ground_half_dimensions.x(), ground_half_dimensions.y());
+
+
+	// create the fixture
+	b2FixtureDef fixture_def;
+	fixture_def.shape = &shape;
+
+	// create the fixture on the rigid body
+	ground_body_->CreateFixture(&fixture_def);
+
+	// update visuals from simulation data
+	ground_.UpdateFromSimulation(ground_body_);
+
+	gef::Matrix44 translationMatrix;
+	translationMatrix.SetIdentity();
+	translationMatrix.SetTranslation(gef::Vector4(0, 0, -1));
+	ground_.set_transform(ground_.transform() * translationMatrix);
+
+
+	ground_body_->SetEnabled(false);
+	
+
+}
+
+// front end things
+void SceneApp::InitFont()
+{
+	font_ = new gef::Font(platform_);
+	font_->Load("comic_sans");
+}
+
+void SceneApp::CleanUpFont()
+{
+	delete font_;
+	font_ = NULL;
+}
+
+// hud
+void SceneApp::DrawHUD()
+{
+	MemoryTagScope ui_tag(MEMORY_TAG_UI);
+
+	if(font_)
+	{
+		// display frame rate
+		font_->RenderText(sprite_renderer_, gef::Vector4(850.0f, 510.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "FPS: %.1f", fps_);
+		font_->RenderText(sprite_renderer_, gef::Vector4(10.0f, 510.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "CPU: %.0fms/s", frame_pacer_.cpu_ms_per_second());
+
+		// physics cost while playing
+		if (game_state_ == GameState_::Level1)
+		{
+			font_->RenderText(sprite_renderer_, gef::Vector4(560.0f, 480.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "Contacts: %d/%d Step: %.2fms", touching_count_, contact_count_, step_time_ms_);
+		}
+
+		// the last state change, and how many state assets came from the preloader
+		const GameStateTransition& transition = transitions_[last_transition_from_][game_state_];
+		if (transition.count > 0)
+		{
+			font_->RenderText(sprite_renderer_, gef::Vector4(10.0f, 480.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "%s->%s: %.2fms Preloaded: %u/%u",
+				kGameStates[last_transition_from_].name, kGameStates[game_state_].name, transition.last_ms,
+				asset_preloader_.hits(), asset_preloader_.hits() + asset_preloader_.misses());
+		}
+
+		// sound effect voices in use, and how many plays took a voice or were turned away
+		if (game_state_ == GameState_::Level1)
+		{
+			font_->RenderText(sprite_renderer_, gef::Vector4(560.0f, 390.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "Voices: %d/%d stolen %u limited %u",
+				sound_voices_.active_voices(), VoicePool::kMaxVoices, sound_voices_.steals(), sound_voices_.limited());
+		}
+
+		// what the CPU mix costs, and the most audio memory there's been
+		if (software_audio_)
+		{
+			font_->RenderText(sprite_renderer_, gef::Vector4(560.0f, 360.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "Mixer: %.2fms %.2fus/voice Audio peak: %uKB",
+				software_mixer_.mix_time_ms(), software_mixer_.voice_us_per_ms(), (UInt32)(MemoryTracker::Stats(MEMORY_TAG_AUDIO).peak_bytes / 1024));
+		}
+
+		// CPU raster cost of the last frame the render thread finished
+		if (render_thread_)
+		{
+			font_->RenderText(sprite_renderer_, gef::Vector4(560.0f, 420.0f, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "Software: %.2fms %d tris %u/%u frames",
+				render_thread_->raster_time_ms(), render_thread_->triangle_count(), render_thread_->frames_drawn(), render_frame_);
+		}
+
+		// live KB per tag, and the allocations made last frame
+		if (show_memory_)
+		{
+			for (int tag = 0; tag < NUM_MEMORY_TAGS; ++tag)
+			{
+				const MemoryTagStats stats = MemoryTracker::Stats((MemoryTag)tag);
+				font_->RenderText(sprite_renderer_, gef::Vector4(10.0f, 20.0f + 30.0f * tag, -0.9f), 1.0f, 0xfffffff, gef::TJ_LEFT, "%s: %uKB peak %uKB (%u/frame)",
+					MemoryTracker::TagName((MemoryTag)tag), (UInt32)(stats.live_bytes / 1024), (UInt32)(stats.peak_bytes / 1024), stats.frame_allocations);
+			}
+		}
+	}
+}
+
+void SceneApp::SetupLights()
+{
+	// grab the data for the default shader used for rendering 3D geometry
+	gef::Default3DShaderData& default_shader_data = renderer_3d_->default_shader_data();
+
+	// set the ambient light
+	default_shader_data.set_ambient_light_colour(gef::Colour(0.50f, 0.25f, 0.25f, 1.0f));
+
+	// add a point light that is almost white, but with a blue tinge
+	// the position of the light is set far away so it acts light a directional light
+	gef::PointLight default_point_light;
+	default_point_light.set_colour(gef::Colour(0.9f, 0.9f, 0.9f, 1.0f));
+	default_point_light.set_position(gef::Vector4(-300.0f, 400.0f, 700.0f));
+	light_manager_.AddLight(default_point_light, 0.0f);
+
+	// lights go through the manager, which replaces the shader's set rather than adding to it
+	light_manager_.Apply(default_shader_data, b2Vec2(0.0f, 0.0f));
+} // lights
+
+// update physics sim
+void SceneApp::UpdateSimulation(float frame_time)
+{
+
+	// update physics world
+	float timeStep = kFixedStep;
+
+	int32 velocityIterations = 6;
+	int32 positionIterations = 2;
+
+	// filter the bodies created since the last step, so pairs that are ignored
+	// anyway never make it into the broadphase
+	collision_layers_.ApplyNew(world_);
+
+	// spread enemies out before box2d has to resolve them overlapping
+	SteerEnemies();
+
+	std::chrono::high_resolution_clock::time_point step_start = std::chrono::high_resolution_clock::now();
+	{
+		MemoryTagScope physics_tag(MEMORY_TAG_PHYSICS);
+		world_->Step(timeStep, velocityIterations, positionIterations);
+	}
+	step_time_ms_ = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - step_start).count();
+
+	// don't have to update the ground visuals as it is static
+
+	// collision detection
+	// get the head of the contact list
+	b2Contact* contact = world_->GetContactList();
+	// get contact count
+	int contact_count = world_->GetContactCount();
+
+	// ray cast bullets move with the same step as the bodies they're tested against
+	projectiles_.Update(timeStep, world_, job_system_);
+	ResolveProjectileHits();
+
+	if (analytic_bounds_)
+	{
+		ApplyArenaBounds();
+	}
+	contact_count_ = contact_count;
+	touching_count_ = 0;
+
+	for (int contact_num = 0; contact_num<contact_count; ++contact_num)
+	{
+		if (contact->IsTouching())
+		{
+			touching_count_++;
+
+			// get the colliding bodies
+			b2Body* bodyA = contact->GetFixtureA()->GetBody();
+			b2Body* bodyB = contact->GetFixtureB()->GetBody();
+
+			// COLLISION RESPONSE HERE
+			PlayerManager* player = NULL;
+			Enemy* enemy = NULL;
+			Bullet* bullet = NULL;
+			Walls* wall = NULL;
+
+			GameObject* gameObjectA = NULL;
+			GameObject* gameObjectB = NULL;
+
+			gameObjectA = reinterpret_cast<GameObject*>(bodyA->GetUserData().pointer);
+			gameObjectB = reinterpret_cast<GameObject*>(bodyB->GetUserData().pointer);
+
+			if (gameObjectA)
+			{
+
+				if (gameObjectA->type() == BULLET)
+				{
+					bullet = reinterpret_cast<Bullet*>(bodyA->GetUserData().pointer);
+				}
+
+				if (gameObjectA->type() == ENEMY)
+				{
+					enemy = reinterpret_cast<Enemy*>(bodyA->GetUserData().pointer);
+				}
+
+				if (gameObjectA->type() == PLAYER)
+				{
+					player = reinterpret_cast<PlayerManager*>(bodyA->GetUserData().pointer);
+				}
+
+				if (gameObjectA->type() == WALL)
+				{
+					wall = reinterpret_cast<Walls*>(bodyA->GetUserData().pointer);
+				}
+
+			}
+
+			if (gameObjectB)
+			{
+				if (gameObjectB->type() == BULLET)
+				{
+					bullet = reinterpret_cast<Bullet*>(bodyB->GetUserData().pointer);
+				}
+
+				if (gameObjectB->type() == ENEMY)
+				{
+					enemy = reinterpret_cast<Enemy*>(bodyB->GetUserData().pointer);
+				}
+
+				if (gameObjectB->type() == PLAYER)
+				{
+					player = reinterpret_cast<PlayerManager*>(bodyB->GetUserData().pointer);
+				}
+
+				if (gameObjectB->type() == WALL)
+				{
+					wall = reinterpret_cast<Walls*>(bodyB->GetUserData().pointer);
+				}
+
+			}
+
+			if (bullet && enemy)
+			{
+				enemy->setDead();
+				enemy->set_spawn_placed(false);
+				sound_voices_.Play(kSoundEnemy);
+				bullet->die();
+				sound_voices_.Play(kSoundPlop);
+				player_one_->incScore();
+			}
+
+			if (player && enemy)
+			{
+				player->decrementLives();
+				//player_one_->decrementLives();
+				//gef::DebugOut("player coll");
+			}
+
+			if (bullet && wall)
+			{
+				sound_voices_.Play(kSoundPlop);
+				bullet->die();
+			}
+
+			
+
+			
+		}
+
+		// Get next contact point
+		contact = contact->GetNext();
+	}
+} //collision
+
+// same responses as the bullet contacts above, for the ray cast bullets
+void SceneApp::ResolveProjectileHits()
+{
+	const std::vector<ProjectileHit>& hits = projectiles_.hits();
+
+	hit_enemies_.clear();
+	for (size_t hit_num = 0; hit_num < hits.size(); ++hit_num)
+	{
+		GameObject* object = hits[hit_num].object;
+
+		if (object->type() == ENEMY)
+		{
+			hit_enemies_.push_back(object);
+		}
+		else if (object->type() == WALL)
+		{
+			sound_voices_.Play(kSoundPlop);
+		}
+	}
+
+	// a spray can put several bullets into one enemy in the same step, it only dies and scores once
+	std::sort(hit_enemies_.begin(), hit_enemies_.end());
+	hit_enemies_.erase(std::unique(hit_enemies_.begin(), hit_enemies_.end()), hit_enemies_.end());
+
+	for (size_t enemy_num = 0; enemy_num < hit_enemies_.size(); ++enemy_num)
+	{
+		reinterpret_cast<Enemy*>(hit_enemies_[enemy_num])->setDead();
+		hit_enemies_[enemy_num]->set_spawn_placed(false);
+		sound_voices_.Play(kSoundEnemy);
+		sound_voices_.Play(kSoundPlop);
+		player_one_->incScore();
+	}
+}
+
+// keep the player and enemies in and retire bullets that have left, what the wall bodies used to do
+void SceneApp::ApplyArenaBounds()
+{
+	arena_bounds_.ClampBody(player_one_->player_body_, kPlayerEdgeMargin);
+
+	// separation and the flow field can push enemies at the edge, there's no wall to stop them.
+	// SteerEnemies has already gathered their bodies this step, only the positions are read again
+	const int enemy_count = (int)enemy_bodies_.size();
+	if (enemy_count > 0)
+	{
+		enemy_x_.resize(enemy_count);
+		enemy_y_.resize(enemy_count);
+		enemy_outside_.resize(enemy_count);
+
+		for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+		{
+			enemy_x_[enemy_num] = enemy_bodies_[enemy_num]->GetPosition().x;
+			enemy_y_[enemy_num] = enemy_bodies_[enemy_num]->GetPosition().y;
+		}
+
+		int num_outside = arena_bounds_.TestOutside(&enemy_x_[0], &enemy_y_[0], enemy_count, &enemy_outside_[0], kEnemyEdgeMargin);
+		for (int enemy_num = 0; num_outside > 0 && enemy_num < enemy_count; ++enemy_num)
+		{
+			if (enemy_outside_[enemy_num])
+			{
+				arena_bounds_.ClampBody(enemy_bodies_[enemy_num], kEnemyEdgeMargin);
+				num_outside--;
+			}
+		}
+	}
+
+	// gather every live bullet body so the bounds test runs over flat arrays
+	bullet_bodies_.clear();
+	bullet_x_.clear();
+	bullet_y_.clear();
+
+	for (b2Body* body = world_->GetBodyList(); body; body = body->GetNext())
+	{
+		GameObject* game_object = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
+		if (game_object && game_object->type() == BULLET && body->IsEnabled())
+		{
+			bullet_bodies_.push_back(body);
+			bullet_x_.push_back(body->GetPosition().x);
+			bullet_y_.push_back(body->GetPosition().y);
+		}
+	}
+
+	int num_retired = 0;
+	const int bullet_count = (int)bullet_bodies_.size();
+	if (bullet_count > 0)
+	{
+		bullet_outside_.resize(bullet_count);
+		num_retired = arena_bounds_.TestOutside(&bullet_x_[0], &bullet_y_[0], bullet_count, &bullet_outside_[0]);
+
+		for (int bullet_num = 0; num_retired > 0 && bullet_num < bullet_count; ++bullet_num)
+		{
+			if (bullet_outside_[bullet_num])
+			{
+				reinterpret_cast<Bullet*>(bullet_bodies_[bullet_num]->GetUserData().pointer)->die();
+			}
+		}
+	}
+
+	num_retired += projectiles_.RetireOutside(arena_bounds_);
+
+	// one plop however many bullets went out this step
+	if (num_retired > 0)
+	{
+		sound_voices_.Play(kSoundPlop);
+	}
+}
+
+// steer enemies along the flow field to the player at the difficulty's speed, and push
+// overlapping ones apart
+void SceneApp::SteerEnemies()
+{
+	enemy_flow_.SetTarget(player_one_->player_body_->GetPosition());
+
+	enemy_bodies_.clear();
+	enemy_positions_.clear();
+
+	// EnemyManager picks where its new enemies go with rand(). any enemy that's come alive
+	// since the last step, new or pooled, is moved to the next point from enemy_spawns_
+	// here, so placement stays on the seeded generator without a walk of its own
+	for (b2Body* body = world_->GetBodyList(); body; body = body->GetNext())
+	{
+		GameObject* game_object = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
+		if (!game_object || game_object->type() != ENEMY)
+			continue;
+
+		if (!body->IsEnabled())
+		{
+			game_object->set_spawn_placed(false);
+			continue;
+		}
+
+		if (!game_object->spawn_placed())
+		{
+			body->SetTransform(enemy_spawns_.Next(), body->GetAngle());
+			game_object->set_spawn_placed(true);
+		}
+
+		enemy_bodies_.push_back(body);
+		enemy_positions_.push_back(body->GetPosition());
+	}
+
+	const int enemy_count = (int)enemy_bodies_.size();
+	if (enemy_count == 0)
+		return;
+
+	enemy_steering_.resize(enemy_count);
+	const float speed = difficulty == kDifficultyHard ? kEnemySpeedHard : kEnemySpeedEasy;
+
+	enemy_grid_.Build(&enemy_positions_[0], enemy_count);
+
+	// work out the new velocities across the job threads, the grid and field are only read
+	job_system_->ParallelFor(enemy_count, kSteeringGrain, [this, speed](int begin, int end)
+	{
+		enemy_grid_.ComputeSeparation(kSeparationRadius, kSeparationStrength, &enemy_steering_[0], begin, end);
+
+		for (int enemy_num = begin; enemy_num < end; ++enemy_num)
+			enemy_steering_[enemy_num] += speed * enemy_flow_.Sample(enemy_positions_[enemy_num]);
+	});
+
+	// box2d isn't thread safe, apply them back here before the step
+	for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+		enemy_bodies_[enemy_num]->SetLinearVelocity(enemy_steering_[enemy_num]);
+}
+
+// more front end stuff idk
+void SceneApp::FrontendInit()
+{
+	MemoryTagScope ui_tag(MEMORY_TAG_UI);
+	//button_icon_ = CreateTextureFromPNG("playstation-cross-dark-icon.png", platform_);
+	// splash
+	loader = LoadTexture(kGameStates[GameState_::Init].texture);
+}
+
+void SceneApp::FrontendRelease()
+{
+	delete loader;
+	loader = NULL;
+}
+
+void SceneApp::FrontendUpdate(float frame_time)
+{
+	//const gef::SonyController* controller = input_manager_->controller_input()->GetController(0);
+}
+
+void SceneApp::FrontendRender()
+{
+	sprite_renderer_->Begin();
+
+	gef::Sprite background;
+	background.set_texture(loader);
+	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
+	background.set_height(platform_.height());
+	background.set_width(platform_.width());
+	sprite_renderer_->DrawSprite(background);
+
+	if (render_thread_ && screen_dirty_)
+	{
+		PublishSpritePacket(background);
+	}
+
+
+	DrawHUD();
+	sprite_renderer_->End();
+}
+
+void SceneApp::MenuInit()
+{
+	MemoryTagScope ui_tag(MEMORY_TAG_UI);
+
+	main_menu = LoadTexture(kGameStates[GameState_::Menu].texture);
+
+}
+
+void SceneApp::MenuRelease()
+{
+
+	delete main_menu;
+	main_menu = NULL;
+}
+
+void SceneApp::MenuUpdate(float frame_time)
+{
+
+	const gef::Keyboard* keyboard = input_manager_->keyboard();
+
+	if (keyboard)
+	{
+		if (keyboard->IsKeyPressed(keyboard->KC_W))
+		{
+			sound_voices_.Play(kSoundPlop);
+
+			if (selected > 0)
+			{
+				selected -= 1;
+			}
+			else
+			{
+				selected = 1;
+			}
+		}
+
+		if (keyboard->IsKeyPressed(keyboard->KC_S))
+		{
+			sound_voices_.Play(kSoundPlop);
+
+			if (selected < 1)
+			{
+				selected += 1;
+			}
+			else
+			{
+				selected = 0;
+			}
+		}
+
+		if (keyboard->IsKeyPressed(keyboard->KC_SPACE))
+		{
+			sound_voices_.Play(kSoundPlop);
+
+			if (selected == 0)
+			{
+				ChangeGameState(Setting);
+			}
+			else if (selected == 1)
+			{
+				ChangeGameState(Exit);
+				
+			}
+		}
+	}
+
+}
+
+void SceneApp::MenuRender()
+{
+
+	sprite_renderer_->Begin();
+
+	gef::Sprite background;
+	background.set_texture(main_menu);
+	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
+	background.set_height(platform_.height());
+	background.set_width(platform_.width());
+	sprite_renderer_->DrawSprite(background);
+
+	if (render_thread_ && screen_dirty_)
+	{
+		PublishSpritePacket(background);
+	}
+
+	// render buttons
+
+	if (selected == 0)
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.5f - 56.0f, -0.99f),
+
+			1.2f,
+
+			0xff0000FF,
+
+			gef::TJ_LEFT,
+
+			"start");
+	}
+	else
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.5f - 56.0f, -0.99f),
+
+			1.0f,
+
+			0xffffffff,
+
+			gef::TJ_LEFT,
+
+			"start");
+	}
+
+	if (selected == 1)
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.7f - 56.0f, -0.99f),
+
+			1.2f,
+
+			0xff0000FF,
+
+			gef::TJ_LEFT,
+
+			"quit");
+	}
+	else
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.6f, platform_.height() * 0.7f - 56.0f, -0.99f),
+
+			1.0f,
+
+			0xffffffff,
+
+			gef::TJ_LEFT,
+
+			"quit");
+	}
+
+	//DrawHUD();
+	sprite_renderer_->End();
+
+}
+
+void SceneApp::SettingsInit()
+{
+	MemoryTagScope ui_tag(MEMORY_TAG_UI);
+	difficulty = 0;
+	settings = LoadTexture(kGameStates[GameState_::Setting].texture);
+
+}
+
+void SceneApp::SettingsRelease()
+{
+
+	delete settings;
+	settings = NULL;
+
+}
+
+void SceneApp::SettingsUpdate(float frame_time)
+{
+
+	const gef::Keyboard* keyboard = input_manager_->keyboard();
+
+	if (keyboard)
+	{
+
+		if (keyboard->IsKeyPressed(keyboard->KC_W))
+		{
+			sound_voices_.Play(kSoundPlop);
+
+			if (selected > 0)
+			{
+				selected -= 1;
+			}
+			else
+			{
+				selected = 1;
+			}
+		}
+
+		if (keyboard->IsKeyPressed(keyboard->KC_S))
+		{
+			sound_voices_.Play(kSoundPlop);
+
+			if (selected < 1)
+			{
+				selected += 1;
+			}
+			else
+			{
+				selected = 0;
+			}
+		}
+
+		if (keyboard->IsKeyPressed(keyboard->KC_SPACE))
+		{
+			sound_voices_.Play(kSoundPlop);
+
+			if (selected == 0)
+			{
+				//ChangeGameState(Setting);
+				// easy difficulty
+				difficulty = kDifficultyEasy;
+				ChangeGameState(Level1);
+			}
+			else if (selected == 1)
+			{
+				//ChangeGameState(Exit);
+				// hard difficulty
+				difficulty = kDifficultyHard;
+				ChangeGameState(Level1);
+
+			}
+		}
+	}
+
+}
+
+void SceneApp::SettingsRender()
+{
+
+	sprite_renderer_->Begin();
+
+	gef::Sprite background;
+	background.set_texture(settings);
+	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
+	background.set_height(platform_.height());
+	background.set_width(platform_.width());
+	sprite_renderer_->DrawSprite(background);
+
+	// render buttons
+
+	if (selected == 0)
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.35f - 56.0f, -0.99f),
+
+			1.2f,
+
+			0xff0000FF,
+
+			gef::TJ_LEFT,
+
+			"easy");
+	}
+	else
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.35f - 56.0f, -0.99f),
+
+			1.0f,
+
+			0xffffffff,
+
+			gef::TJ_LEFT,
+
+			"easy");
+	}
+
+	if (selected == 1)
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.45f - 56.0f, -0.99f),
+
+			1.2f,
+
+			0xff0000FF,
+
+			gef::TJ_LEFT,
+
+			"hard");
+	}
+	else
+	{
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.4f, platform_.height() * 0.45f - 56.0f, -0.99f),
+
+			1.0f,
+
+			0xffffffff,
+
+			gef::TJ_LEFT,
+
+			"hard");
+	}
+
+	//DrawHUD();
+	sprite_renderer_->End();
+
+}
+
+void SceneApp::OverInit()
+{
+	MemoryTagScope ui_tag(MEMORY_TAG_UI);
+	//get player score
+	endscreen = LoadTexture(kGameStates[GameState_::OVER].texture);
+
+}
+
+void SceneApp::OverRelease()
+{
+	delete endscreen;
+	endscreen = NULL;
+}
+
+void SceneApp::ExitInit()
+{
+	quitOut = true;
+}
+
+void SceneApp::OverUpdate(float frame_time)
+{
+	const gef::Keyboard* keyboard = input_manager_->keyboard();
+
+	if (keyboard)
+	{
+		if (keyboard->IsKeyPressed(keyboard->KC_SPACE))
+		{
+				//ChangeGameState(Setting);
+				// easy difficulty
+				difficulty = kDifficultyEasy;
+				ChangeGameState(Menu);
+		}
+	}
+}
+
+void SceneApp::OverRender()
+{
+	sprite_renderer_->Begin();
+
+	gef::Sprite background;
+	background.set_texture(endscreen);
+	background.set_position(gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f, -0.99f));
+	background.set_height(platform_.height());
+	background.set_width(platform_.width());
+	sprite_renderer_->DrawSprite(background);
+
+	// render buttons
+
+	std::string str;
+	str.append("Final Score: ");
+	str.append(std::to_string(finalScore)); // gets the score as int)
+	char const* pchar = str.c_str(); // casts it to a const char
+
+		font_->RenderText(
+			sprite_renderer_,
+
+			gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.45f - 56.0f, -0.99f),
+
+			1.2f,
+
+			0xff0000FF,
+
+			gef::TJ_LEFT,
+
+			pchar);
+	
+
+	
+	//DrawHUD();
+	sprite_renderer_->End();
+
+
+}
+
+// game init
+void SceneApp::GameInit()
+{
+	// the renderer, meshes and world outlive a play-through, only the entities are rebuilt
+	if (!level_loaded_)
+	{
+		LevelLoad();
+	}
+
+	ResetLevel();
+}
+
+// delete
+void SceneApp::GameRelease()
+{
+	const int difficulty_index = difficulty == kDifficultyHard ? 1 : 0;
+	gef::DebugOut("Level arena: %u of %u bytes (%u level, %u play-through), peak %u for difficulty %d, %u overflowed to the heap\n",
+		(UInt32)level_arena_.used(), (UInt32)level_arena_.capacity(), (UInt32)level_arena_mark_, (UInt32)(level_arena_.used() - level_arena_mark_),
+		(UInt32)level_arena_peak_[difficulty_index], difficulty, (UInt32)level_arena_.overflow_bytes());
+
+	// the entities go now, the renderer, meshes and world stay until CleanUp
+	ReleaseEntities();
+}
+
+// everything that doesn't change between play-throughs, loaded the first time Level1 is entered
+void SceneApp::LevelLoad()
+{
+	gef::Colour colour_;
+	colour_.SetFromRGBA(0x0c0c0a00);
+	platform_.set_render_target_clear_colour(colour_);
+
+
+	// the level's own allocations come out of the arena. what's in it once LevelLoad is
+	// done stays until LevelUnload, each play-through's entities go on top of that
+	level_arena_.Init(kLevelArenaSize);
+
+	{
+		MemoryTagScope render_tag(MEMORY_TAG_RENDER);
+
+		// create the renderer for draw 3D geometry
+		renderer_3d_ = gef::Renderer3D::Create(platform_);
+
+		{
+			MemoryArenaScope level_scope(&level_arena_);
+
+			// initialise primitive builder to make create some 3D geometry easier
+			primitive_builder_ = new PrimitiveBuilder(platform_);
+			ground_mesh_ = primitive_builder_->CreateBoxMesh(gef::Vector4(kArenaHalfWidth, kArenaHalfHeight, 0.5f));
+		}
+
+		light_manager_.Init(kArenaHalfWidth, kArenaHalfHeight, kLightCellSize);
+		SetupLights();
+	}
+
+	{
+		MemoryTagScope physics_tag(MEMORY_TAG_PHYSICS);
+
+		// initialise the physics world
+		b2Vec2 gravity(0.0f, 0.0f);
+		world_ = new b2World(gravity);
+	}
+
+	enemy_grid_.Init(kArenaHalfWidth, kArenaHalfHeight, kSeparationRadius);
+	enemy_flow_.Init(kArenaHalfWidth, kArenaHalfHeight, kFlowCellSize);
+	projectiles_.Init(kMaxProjectiles, primitive_builder_->GetDefaultSphereMesh());
+	arena_bounds_.Init(kArenaHalfWidth, kArenaHalfHeight);
+	snapshots_.Init(kSnapshotCount, kSnapshotInterval);
+
+	{
+		MemoryArenaScope level_scope(&level_arena_);
+
+		enemy_bodies_.reserve(kMaxGatheredBodies);
+		enemy_positions_.reserve(kMaxGatheredBodies);
+		enemy_steering_.reserve(kMaxGatheredBodies);
+		enemy_x_.reserve(kMaxGatheredBodies);
+		enemy_y_.reserve(kMaxGatheredBodies);
+		enemy_outside_.reserve(kMaxGatheredBodies);
+		hit_enemies_.reserve(kMaxGatheredBodies);
+		bullet_bodies_.reserve(kMaxGatheredBodies);
+		bullet_x_.reserve(kMaxGatheredBodies);
+		bullet_y_.reserve(kMaxGatheredBodies);
+		bullet_outside_.reserve(kMaxGatheredBodies);
+	}
+
+	{
+		MemoryTagScope assets_tag(MEMORY_TAG_ASSETS);
+		MemoryArenaScope level_scope(&level_arena_);
+		initOcean();
+	}
+
+	level_arena_mark_ = level_arena_.used();
+	level_loaded_ = true;
+}
+
+void SceneApp::LevelUnload()
+{
+	ReleaseEntities();
+
+	// destroying the physics world also destroys all the objects within it
+	delete world_;
+	world_ = NULL;
+
+	delete ground_mesh_;
+	ground_mesh_ = NULL;
+
+	delete scene_assets_;
+	scene_assets_ = NULL;
+
+	delete pondtex;
+	pondtex = NULL;
+
+	delete pond_texture_;
+	pond_texture_ = NULL;
+
+	delete primitive_builder_;
+	primitive_builder_ = NULL;
+
+	delete renderer_3d_;
+	renderer_3d_ = NULL;
+
+	// the gather buffers hold arena memory too, they have to let go of it before it's freed
+	ReleaseVector(enemy_bodies_);
+	ReleaseVector(enemy_positions_);
+	ReleaseVector(enemy_steering_);
+	ReleaseVector(enemy_x_);
+	ReleaseVector(enemy_y_);
+	ReleaseVector(enemy_outside_);
+	ReleaseVector(hit_enemies_);
+	ReleaseVector(bullet_bodies_);
+	ReleaseVector(bullet_x_);
+	ReleaseVector(bullet_y_);
+	ReleaseVector(bullet_outside_);
+
+	level_arena_.Release();
+	level_arena_mark_ = 0;
+
+	level_loaded_ = false;
+}
+
+// start a play-through without reloading anything, the world is emptied and the entities made again
+void SceneApp::ResetLevel()
+{
+	MemoryTagScope gameplay_tag(MEMORY_TAG_GAMEPLAY);
+
+	ReleaseEntities();
+
+	step_accumulator_ = 0.0f;
+
+	// same spawn sequence every play-through of a session
+	enemy_spawns_.Init(rng_seed_, kArenaHalfWidth - 1.0f, kArenaHalfHeight - 1.0f);
+	step_rand_.Seed(rng_seed_, RNG_STEP_RAND);
+
+	{
+		// the managers and whatever they new for their entities while they're built. only
+		// construction goes in the arena, deletes in it are no-ops until the next ResetTo,
+		// so anything made and dropped during play would use it up for good
+		MemoryArenaScope level_scope(&level_arena_);
+
+		//InitPlayer();
+		//player_one_->InitPlayer();
+		player_one_ = level_arena_.New<PlayerManager>(primitive_builder_, world_, renderer_3d_, &platform_);
+		player_one_->InitPlayer();
+
+		// initialise enemy manager
+		enemy_manager_ = level_arena_.New<EnemyManager>(world_, sprite_renderer_, renderer_3d_, primitive_builder_, &platform_, difficulty);
+		enemy_manager_->InitEnemies();
+
+		playerBullets_ = level_arena_.New<BulletManager>(world_, sprite_renderer_, renderer_3d_, primitive_builder_);
+		playerBullets_->InitBullets();
+	}
+
+	// nothing else goes in the arena during play, so this is the play-through's whole use
+	const int difficulty_index = difficulty == kDifficultyHard ? 1 : 0;
+	if (level_arena_.used() > level_arena_peak_[difficulty_index])
+	{
+		level_arena_peak_[difficulty_index] = level_arena_.used();
+	}
+
+	// the heap still has what didn't fit, but the arena's sized to hold it all
+	if (level_arena_.overflow_bytes() > 0)
+	{
+		gef::DebugOut("Error: level arena overflowed %u bytes to the heap, kLevelArenaSize (%u) is too small\n",
+			(UInt32)level_arena_.overflow_bytes(), (UInt32)level_arena_.capacity());
+	}
+
+	projectiles_.Clear();
+
+	InitGround();
+
+	// walls stay as meshes only, the bounds test stands in for their bodies
+	if (analytic_bounds_)
+	{
+		for (b2Body* body = world_->GetBodyList(); body; body = body->GetNext())
+		{
+			GameObject* game_object = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
+			if (game_object && game_object->type() == WALL)
+			{
+				body->SetEnabled(false);
+			}
+		}
+	}
+
+	// the enemies InitEnemies starts with keep their places, only later spawns are moved
+	for (b2Body* body = world_->GetBodyList(); body; body = body->GetNext())
+	{
+		GameObject* game_object = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
+		if (game_object && game_object->type() == ENEMY)
+		{
+			game_object->set_spawn_placed(body->IsEnabled());
+		}
+	}
+
+	collision_layers_.Init(difficulty == kDifficultyHard);
+	collision_layers_.Apply(world_);
+
+	// snapshots from the last play-through don't match the new bodies
+	snapshots_.Clear();
+}
+
+// the managers don't own their bodies, so they go first and the bodies are cleared out of the world after
+void SceneApp::ReleaseEntities()
+{
+	level_arena_.Delete(player_one_);
+	player_one_ = NULL;
+
+	level_arena_.Delete(playerBullets_);
+	playerBullets_ = NULL;
+
+	level_arena_.Delete(enemy_manager_);
+	enemy_manager_ = NULL;
+
+	// the level's meshes and scene data below the mark stay
+	level_arena_.ResetTo(level_arena_mark_);
+
+	if (world_)
+	{
+		b2Body* body = world_->GetBodyList();
+		while (body)
+		{
+			b2Body* next = body->GetNext();
+			world_->DestroyBody(body);
+			body = next;
+		}
+	}
+}
+
+// game update
+void SceneApp::GameUpdate(float frame_time)
+{
+	const gef::SonyController* controller = input_manager_->controller_input()->GetController(0);
+
+	//audio_manager_->PlayMusic();
+
+	// the simulation waits while rewinding
+	const gef::Keyboard* keyboard = input_manager_->keyboard();
+	if (keyboard && keyboard->IsKeyDown(gef::Keyboard::KC_R))
+	{
+		input_events_.Flush(step_keys_);
+		RewindLevel();
+		return;
+	}
+
+	if (!player_one_->playerStatus()) // while the player is still alive
+	{
+		step_accumulator_ += frame_time;
+		int substeps = (int)(step_accumulator_ / kFixedStep);
+		if (substeps > kMaxSubsteps)
+		{
+			substeps = kMaxSubsteps;
+			step_accumulator_ = substeps * kFixedStep;
+		}
+		step_accumulator_ -= substeps * kFixedStep;
+
+		// the steps cover the frame time up to now, each one gets the key events that
+		// came in before its end, so a press lands in the step it happened in. the last
+		// one takes everything up to now, a press in the leftover time would otherwise
+		// wait for a later frame than polling the keys now would see it in
+		const double now = InputPoller::Now();
+		for (int substep = 0; substep < substeps && !player_one_->playerStatus(); ++substep)
+		{
+			const double step_end = substep == substeps - 1 ? now : now - step_accumulator_ - (substeps - 1 - substep) * kFixedStep;
+			input_events_.Apply(step_end, step_keys_);
+			step_input_->scripted_keyboard().SetKeys(step_keys_);
+
+			// EnemyManager draws from rand(), reseeding each step keeps it in the rewind state
+			srand(step_rand_.NextUInt32());
+
+			//input_manager_->keyboard()->Update();
+			if (raycast_bullets_)
+			{
+				projectiles_.CreateNew(step_input_, player_one_->player_body_->GetPosition(), kFixedStep);
+			}
+			else
+			{
+				playerBullets_->CreateNew(step_input_, player_one_->player_body_->GetPosition(), kFixedStep);
+			}
+
+			player_one_->MovePlayer(kFixedStep, step_input_); //update physics
+
+			// SteerEnemies places whatever this spawns before the world steps
+			enemy_manager_->CreateNew(kFixedStep);
+
+			UpdateSimulation(kFixedStep); // UPDATES PHYSICS
+
+			//update player sim
+			player_one_->Update(kFixedStep);
+
+			if (!player_one_->playerStatus()) // while the player is still alive
+			{
+				// update enemies
+				enemy_manager_->Update(kFixedStep, player_one_->player_body_->GetPosition());
+			}
+
+			// update bullets
+			playerBullets_->Update(kFixedStep);
+
+			RewindState rewind_state;
+			rewind_state.state_timer = state_timer;
+			rewind_state.enemy_spawns = enemy_spawns_;
+			rewind_state.step_rand = step_rand_.state();
+			snapshots_.Update(world_, &rewind_state, sizeof(RewindState));
+		}
+	}
+	else if (player_one_->playerStatus())
+	{
+		finalScore = player_one_->getScore();
+		ChangeGameState(OVER);
+	}
+	
+
+}
+
+// steps back one snapshot, returns false once there's nothing left to go back to
+bool SceneApp::RewindLevel()
+{
+	RewindState rewind_state;
+	if (!snapshots_.Rewind(world_, &rewind_state, sizeof(RewindState)))
+		return false;
+
+	state_timer = rewind_state.state_timer;
+	enemy_spawns_ = rewind_state.enemy_spawns;
+	step_rand_.set_state(rewind_state.step_rand);
+
+	// ray cast bullets aren't bodies so aren't in the snapshot, drop them rather than leave them out of step
+	projectiles_.Clear();
+
+	return true;
+}
+
+// game render, camera etc
+void SceneApp::GameRender()
+{
+	// setup camera
+
+	// projection
+	float fov = gef::DegToRad(45.0f);
+	float aspect_ratio = (float)platform_.width() / (float)platform_.height();
+	gef::Matrix44 projection_matrix;
+	projection_matrix = platform_.PerspectiveProjectionFov(fov, aspect_ratio, 0.1f, 100.0f);
+	renderer_3d_->set_projection_matrix(projection_matrix); 
+
+
+	// view
+	//gef::Vector4 camera_eye(0.0f, -10.0f, 70.0f); // pos of the camera in space (frustrum <3)
+	gef::Vector4 camera_eye(0.0f + player_one_->player_body_->GetPosition().x, -10.0f + player_one_->player_body_->GetPosition().y, 50.0f); // pos of the camera in space (frustrum <3)
+	gef::Vector4 camera_lookat(player_one_->player_body_->GetPosition().x, player_one_->player_body_->GetPosition().y, 0.0f); // what the camera is positioned to look at 
+	gef::Vector4 camera_up(0.0f, 1.0f, 0.0f); // up vector <3333
+	gef::Matrix44 view_matrix;
+	view_matrix.LookAt(camera_eye, camera_lookat, camera_up);
+	renderer_3d_->set_view_matrix(view_matrix);
+
+
+	// the managers draw internally, so lights are picked per group rather than per object:
+	// the arena around its centre, everything else around the player where the action is.
+	// Begin hands the shader its lights, so each group gets its own Begin
+	gef::Default3DShaderData& shader_data = renderer_3d_->default_shader_data();
+	const b2Vec2 player_position = player_one_->player_body_->GetPosition();
+	light_manager_.Apply(shader_data, b2Vec2(0.0f, 0.0f));
+
+	// draw 3d geometry
+	renderer_3d_->Begin();
+
+	//renderer_3d_->set_override_material(mat);
+	renderer_3d_->DrawMesh(mesh_instance_);
+
+	// draw ground
+	renderer_3d_->set_override_material(pondtex);
+	renderer_3d_->DrawMesh(ground_);
+	renderer_3d_->set_override_material(NULL);
+
+
+	// draw wall
+	//renderer_3d_->DrawMesh(wall_);
+	wallOne.renderWall();
+	wallTwo.renderWall();
+	wallThree.renderWall();
+	wallFour.renderWall();
+
+	renderer_3d_->End();
+
+	//// draw player
+	light_manager_.Apply(shader_data, player_position);
+	renderer_3d_->Begin(false);
+	player_one_->Render();
+
+	// draw Enemies
+	enemy_manager_->Render();
+
+	// draw bullets 
+	playerBullets_->Render();
+	projectiles_.Render(renderer_3d_);
+
+	renderer_3d_->End();
+
+	if (render_thread_)
+	{
+		PublishGamePacket(projection_matrix, view_matrix);
+	}
+
+	// start drawing sprites, but don't clear the frame buffer
+	sprite_renderer_->Begin(false);
+	DrawHUD();
+	sprite_renderer_->End();
+}
+
+void SceneApp::MarkScreenActive()
+{
+	screen_active_time_ = kScreenActiveTime;
+	screen_dirty_ = true;
+}
+
+// static screens run at the active rate for a moment after anything changes and idle
+// the rest of the time. gef clears and presents every frame, so they still have to draw
+// each one, but nothing is spinning between frames
+void SceneApp::PaceFrame(float frame_time)
+{
+	frame_pacer_.Sample();
+
+	// replays run flat out, and in game the swap interval does the pacing
+	if (scripted_input_ || game_state_ == GameState_::Level1)
+	{
+		screen_dirty_ = true;
+		return;
+	}
+
+	screen_active_time_ -= frame_time;
+	frame_pacer_.set_interval(screen_active_time_ > 0.0f ? kActiveFrameInterval : kIdleFrameInterval);
+	frame_pacer_.Wait();
+}
+
+// copies the frame into a packet for the render thread. the managers draw internally,
+// so their objects are picked up from the world's bodies instead
+void SceneApp::PublishGamePacket(const gef::Matrix44& projection_matrix, const gef::Matrix44& view_matrix)
+{
+	RenderPacket* packet = render_packets_.BeginWrite();
+	packet->frame = render_frame_++;
+	packet->clear_colour = kSoftwareClearColour;
+	packet->projection_matrix = projection_matrix;
+	packet->view_matrix = view_matrix;
+
+	packet->AddMesh(mesh_instance_, kSoftwarePondColour);
+	packet->AddMesh(ground_, kSoftwareGroundColour);
+
+	for (b2Body* body = world_->GetBodyList(); body; body = body->GetNext())
+	{
+		GameObject* game_object = reinterpret_cast<GameObject*>(body->GetUserData().pointer);
+
+		// walls are still drawn when the bounds test has switched their bodies off
+		if (game_object && (body->IsEnabled() || game_object->type() == WALL))
+		{
+			packet->AddMesh(*game_object, SoftwareColour(game_object->type()));
+		}
+	}
+
+	projectiles_.AddToPacket(*packet, kSoftwareBulletColour);
+
+	packet->fps = fps_;
+	packet->touching_count = touching_count_;
+	packet->contact_count = contact_count_;
+	packet->step_time_ms = step_time_ms_;
+
+	render_packets_.EndWrite();
+}
+
+void SceneApp::PublishSpritePacket(const gef::Sprite& background)
+{
+	RenderPacket* packet = render_packets_.BeginWrite();
+	packet->frame = render_frame_++;
+	packet->clear_colour = kSoftwareClearColour;
+	packet->projection_matrix.SetIdentity();
+	packet->view_matrix.SetIdentity();
+	packet->AddQuad(background.position().x(), background.position().y(), background.width(), background.height(), background.colour());
+
+	packet->fps = fps_;
+	packet->touching_count = 0;
+	packet->contact_count = 0;
+	packet->step_time_ms = 0.0f;
+
+	render_packets_.EndWrite();
+}
+
+// model loading
+
+//backgriound pond // initially waves but changed to pond model
+void SceneApp::initOcean()
+{
+	// load the assets in from the .scn
+	const char* scene_asset_filename = kGameStates[GameState_::Level1].scene;
+	scene_assets_ = LoadScene(scene_asset_filename);
+	if (scene_assets_)
+	{
+		mesh_instance_.set_mesh(modelLoader->GetMeshFromSceneAssets(scene_assets_));
+	}
+	else
+	{
+		gef::DebugOut("Scene file %s failed to load\n", scene_asset_filename);
+	}
+
+	
+	gef::Matrix44 rotation_;
+	rotation_.SetIdentity();
+	rotation_.RotationX(gef::DegToRad(90));
+	//mesh_instance_.set_transform(mesh_instance_.transform() * rotation_);
+
+
+	gef::Matrix44 translate_;
+	translate_.SetIdentity();
+	translate_.Scale(gef::Vector4(50, 50, 0));
+	translate_.SetTranslation(gef::Vector4(0, 0, -50));
+
+	mesh_instance_.set_transform(rotation_ * translate_);
+
+	pond_texture_ = LoadTexture(kGameStates[GameState_::Level1].texture);
+
+	pondtex = new gef::Material();
+	//pondtex->set_colour();
+	pondtex->set_texture(pond_texture_);
+
+	
+	
+}
+
+
+///////////////////////////////////////////////////// game states //////////////////////////////////////////////////////
+
+
+void SceneApp::InitStateUpdate(float frame_time)
+{
+	
+	// splash screen
+
+	if (state_timer > 4.0f)
+	{
+		ChangeGameState(GameState_::Menu);
+	}
+}
+
+void SceneApp::InitStateRender()
+{
+	
+	// splash
+	FrontendRender();
+
+}
+
+//void SceneApp::MenuStateUpdate(float frame_time)
+//{
+//	//update menu
+//
+//}
+//
+//void SceneApp::MenuStateRender()
+//{
+//
+//	// render menu
+//
+//	sprite_renderer_->Begin();
+//
+//	// render "TO START" text
+//	font_->RenderText(
+//		sprite_renderer_,
+//		gef::Vector4(platform_.width() * 0.5f, platform_.height() * 0.5f + 32.0f, -0.99f),
+//		1.0f,
+//		0xffffffff,
+//		gef::TJ_CENTRE,
+//		"MENU");
+//
+//
+//	DrawHUD();
+//	sprite_renderer_->End();
+//}
+
+void SceneApp::GameStateInit()
+{
+
+	GameInit();
+
+}
+
+void SceneApp::GameStateUpdate(float frame_time)
+{
+
+	GameUpdate(frame_time);
+
+}
+
+void SceneApp::GameStateRender()
+{
+	sprite_renderer_->Begin();
+
+	renderer_3d_->Begin();
+
+	GameRender();
+
+	std::string str;
+	str.append("Score: ");
+	str.append(std::to_string(player_one_->getScore())); // gets the score as int)
+	char const* pchar = str.c_str(); // casts it to a const char
+
+	std::string Lstr;
+	Lstr.append("Lives Left: ");
+	Lstr.append(std::to_string(player_one_->playerLiveCount())); // gets the score as int)
+	char const* Lchar = Lstr.c_str(); // casts it to a const char
+
+	// render "life and score " text
+	font_->RenderText(
+		sprite_renderer_,
+
+		gef::Vector4(platform_.width() * 0.02f, platform_.height() * 0.04f + 32.0f, -0.99f),
+
+		1.0f,
+
+		0xff0000FF,
+
+		gef::TJ_LEFT,
+
+		pchar);
+
+	font_->RenderText(
+		sprite_renderer_,
+
+		gef::Vector4(platform_.width() * 0.02f, platform_.height() * 0.08f + 32.0f, -0.99f),
+
+		1.0f,
+
+		0xff0000FF,
+
+		gef::TJ_LEFT,
+
+		Lchar);
+
+
+
+
+	DrawHUD();
+
+	renderer_3d_->End();
+
+	sprite_renderer_->End();
+
+
+}
+
+void SceneApp::GameStateRelease()
+{
+	GameRelease();
+}
+
+void SceneApp::ChangeGameState(GameState_ new_state)
+{
+	std::chrono::high_resolution_clock::time_point change_start = std::chrono::high_resolution_clock::now();
+
+	//clean up old state
+	const GameState_ old_state = game_state_;
+	const GameStateInfo& old_info = kGameStates[old_state];
+	if (old_info.exit)
+	{
+		(this->*old_info.exit)();
+	}
+
+	// init new state
+	EnterGameState(new_state);
+
+	GameStateTransition& transition = transitions_[old_state][new_state];
+	transition.last_ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - change_start).count();
+	transition.max_ms = std::max(transition.max_ms, transition.last_ms);
+	transition.count++;
+	last_transition_from_ = old_state;
+
+	gef::DebugOut("State change %s -> %s: %.2fms\n", old_info.name, kGameStates[new_state].name, transition.last_ms);
+}
+
+void SceneApp::EnterGameState(GameState_ new_state)
+{
+	game_state_ = new_state;
+	state_timer = 0;
+
+	const GameStateInfo& state = kGameStates[new_state];
+	if (state.enter)
+	{
+		(this->*state.enter)();
+	}
+
+	PreloadGameState(state.likely_next);
+
+	MarkScreenActive();
+}
+
+void SceneApp::PreloadGameState(GameState_ state)
+{
+	// the level's assets are kept after the first play-through, so there's nothing to fetch
+	if (state == GameState_::Level1 && level_loaded_)
+	{
+		return;
+	}
+
+	const GameStateInfo& info = kGameStates[state];
+	if (info.texture)
+	{
+		asset_preloader_.RequestTexture(info.texture);
+	}
+
+	if (info.scene)
+	{
+		asset_preloader_.RequestScene(info.scene);
+	}
+}
+
+gef::Texture* SceneApp::LoadTexture(const char* filename)
+{
+	gef::Texture* texture = asset_preloader_.TakeTexture(filename);
+	if (!texture)
+	{
+		texture = modelLoader->CreateTextureFromPNG(filename, platform_);
+	}
+
+	return texture;
+}
+
+gef::Scene* SceneApp::LoadScene(const char* filename)
+{
+	gef::Scene* scene = asset_preloader_.TakeScene(filename);
+	if (!scene)
+	{
+		scene = LoadCompactScene(platform_, filename);
+	}
+
+	return scene;
+}
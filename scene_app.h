@@ -1,187 +1,406 @@
-#ifndef _SCENE_APP_H
-#define _SCENE_APP_H
-
-#include <system/application.h>
-#include <maths/vector2.h>
-#include "primitive_builder.h"
-#include <graphics/mesh_instance.h>
-#include <input/input_manager.h>
-#include <box2d/Box2D.h>
-#include "game_object.h"
-#include "PlayerManager.h"
-#include "EnemyManager.h"
-#include "BulletManager.h"
-#include "Walls.h"
-#include <graphics/scene.h>
-#include <assets/png_loader.h>
-#include <graphics/image_data.h>
-#include <graphics/texture.h>
-#include <cstdlib>
-#include "ModelLoading.h"
-#include <audio/audio_manager.h>
-
-// FRAMEWORK FORWARD DECLARATIONS
-namespace gef
-{
-	class Platform;
-	class SpriteRenderer;
-	class Font;
-	class InputManager;
-	class Renderer3D;
-	class Mesh;
-	class Scene;
-}
-
-enum GameState_ {
-	Init,
-	Menu,
-	Level1,
-	Exit,
-	Setting,
-	OVER
-};
-
-class SceneApp : public gef::Application
-{
-public:
-	SceneApp(gef::Platform& platform);
-	void Init();
-	void CleanUp();
-	bool Update(float frame_time);
-	void Render();
-private:
-	//void InitPlayer();
-	void InitGround();
-	void InitFont();
-	void CleanUpFont();
-	void DrawHUD();
-	void SetupLights();
-	void UpdateSimulation(float frame_time);
-    
-	gef::SpriteRenderer* sprite_renderer_;
-	gef::Font* font_;
-	gef::InputManager* input_manager_;
-
-	gef::AudioManager* audio_manager_;
-	//int bullet, die, hurt;
-	
-
-	//
-	// FRONTEND DECLARATIONS
-	//
-	//gef::Texture* button_icon_;
-
-	//
-	// GAME DECLARATIONS
-	//
-	gef::Renderer3D* renderer_3d_;
-	PrimitiveBuilder* primitive_builder_;
-
-	// create the physics world
-	b2World* world_;
-
-	// player variables
-//	Player player_;
-//	b2Body* player_body_;
-
-	PlayerManager* player_one_;
-
-	// Enemy Manager
-	EnemyManager* enemy_manager_;
-
-	// bullet mananger
-
-	BulletManager* playerBullets_;
-
-	// ground variables
-	gef::Mesh* ground_mesh_;
-	GameObject ground_;
-	b2Body* ground_body_;
-
-	GameObject water;
-
-	// scene
-
-	gef::MeshInstance mesh_instance_;
-	gef::Scene* scene_assets_;
-
-	// model loader
-	ModelLoading* modelLoader;
-
-	// wall borders
-	Walls wallOne;
-	Walls wallTwo;
-	Walls wallThree;
-	Walls wallFour;
-
-	// audio variables
-	int sfx_id_;
-	int sfx_voice_id_;
-
-	float fps_;
-
-	GameState_ game_state_;
-	float state_timer;
-
-	void FrontendInit();
-	void FrontendRelease();
-	void FrontendUpdate(float frame_time);
-	void FrontendRender();
-
-	void MenuInit();
-	void MenuRelease();
-	void MenuUpdate(float frame_time);
-	void MenuRender();
-
-	void SettingsInit();
-	void SettingsRelease();
-	void SettingsUpdate(float frame_time);
-	void SettingsRender();
-
-	void OverInit();
-	void OverRelease();
-	void OverUpdate(float frame_time);
-	void OverRender();
-
-	gef::Texture* main_menu;
-	gef::Texture* loader;
-	gef::Texture* settings;
-	gef::Texture* endscreen;
-
-	int selected;
-
-	void GameInit();
-	void GameRelease();
-	void GameUpdate(float frame_time);
-	void GameRender();
-
-	void initOcean();
-
-	/*gef::Scene* LoadSceneAssets(gef::Platform& platform, const char* filename);
-
-	gef::Mesh* GetMeshFromSceneAssets(gef::Scene* scene);
-
-	gef::Texture* CreateTextureFromPNG(const char* png_filename, gef::Platform& platform);*/
-
-	//gef::Material* mat; 
-	gef::Material* pondtex;
-
-
-	void InitStateUpdate(float frame_time);
-	void InitStateRender();
-	
-	void GameStateInit();
-	void GameStateUpdate(float frame_time);
-	void GameStateRender();
-	void GameStateRelease();
-
-	int difficulty;
-	int finalScore;
-
-	void ChangeGameState(GameState_ new_state);
-
-	bool quitOut;
-
-};
-
-#endif // _SCENE_APP_H
+#ifndef _SCENE_APP_H
+#define _SCENE_APP_H
+
+#include <system/application.h>
+#include <maths/vector2.h>
+#include "primitive_builder.h"
+#include <graphics/mesh_instance.h>
+#include <input/input_manager.h>
+#include <box2d/Box2D.h>
+#include "game_object.h"
+#include "PlayerManager.h"
+#include "EnemyManager.h"
+#include "BulletManager.h"
+#include "Walls.h"
+#include <graphics/scene.h>
+#include <assets/png_loader.h>
+#include <graphics/image_data.h>
+#include <graphics/texture.h>
+#include <cstdlib>
+#include "ModelLoading.h"
+#include <audio/audio_manager.h>
+#include "InputRecorder.h"
+#include "SpawnQueue.h"
+#include "SpatialHash.h"
+#include "FlowField.h"
+#include "JobSystem.h"
+#include "CollisionLayers.h"
+#include "ProjectileSystem.h"
+#include "ArenaBounds.h"
+#include "WorldSnapshot.h"
+#include "LinearArena.h"
+#include "MemoryTracker.h"
+#include "LightManager.h"
+#include "SoftwareRenderer.h"
+#include "RenderThread.h"
+#include "FramePacer.h"
+#include "AssetPreloader.h"
+#include "SampleBank.h"
+#include "VoicePool.h"
+#include "SoftwareMixer.h"
+#include "MusicStream.h"
+#include "InputEventQueue.h"
+#include <vector>
+#include <string>
+
+// FRAMEWORK FORWARD DECLARATIONS
+namespace gef
+{
+	class Platform;
+	class SpriteRenderer;
+	class Font;
+	class InputManager;
+	class Renderer3D;
+	class Mesh;
+	class Scene;
+	class Sprite;
+}
+
+// game state a rewind puts back along with the bodies. score, lives, alive flags and
+// spawn timers live inside the managers with no way to set them, so those carry on as
+// they are, and bodies of entities that died since stay where they are (see WorldSnapshot)
+struct RewindState
+{
+	float state_timer;
+	SpawnQueue enemy_spawns;
+	Random::State step_rand;
+};
+
+enum GameState_ {
+	Init,
+	Menu,
+	Level1,
+	Exit,
+	Setting,
+	OVER,
+	NUM_GAME_STATES
+};
+
+class SceneApp : public gef::Application
+{
+public:
+	SceneApp(gef::Platform& platform);
+	void Init();
+	void CleanUp();
+	bool Update(float frame_time);
+	void Render();
+
+	// call before Run, replays feed the recorded keys and frame times back through input_manager_
+	void RecordInput(const char* filename);
+	void ReplayInput(const char* filename);
+
+	// bullets as ray cast segments instead of BulletManager rigid bodies
+	inline void UseRaycastBullets(bool raycast_bullets) { raycast_bullets_ = raycast_bullets; }
+
+	// keeps the four wall bodies in the world instead of the arena bounds test, to compare the two
+	inline void UseWallBodies(bool wall_bodies) { analytic_bounds_ = !wall_bodies; }
+
+	// per tag memory on the HUD, and a report of it written to filename on CleanUp
+	inline void ShowMemory(bool show_memory) { show_memory_ = show_memory; }
+	inline void ReportMemory(const char* filename) { memory_report_filename_ = filename; }
+
+	// also draws the game and menus on the CPU rasteriser, for timing without a GPU
+	inline void UseSoftwareRenderer(bool use_software_renderer) { use_software_renderer_ = use_software_renderer; }
+
+	// no gef::AudioManager, the voice pool still runs against a counting output
+	inline void UseNullAudio(bool null_audio) { null_audio_ = null_audio; }
+
+	// mixes on the CPU instead of through gef, to nowhere or to a wav file
+	inline void UseSoftwareAudio(bool software_audio) { software_audio_ = software_audio; }
+	inline void CaptureAudio(const char* filename) { audio_capture_filename_ = filename; software_audio_ = true; }
+private:
+	//void InitPlayer();
+	void InitGround();
+	void InitFont();
+	void CleanUpFont();
+	void DrawHUD();
+	void SetupLights();
+
+	// every light in the level, the shader gets the few nearest each draw
+	LightManager light_manager_;
+	void UpdateSimulation(float frame_time);
+	void SteerEnemies();
+    
+	gef::SpriteRenderer* sprite_renderer_;
+	gef::Font* font_;
+	gef::InputManager* input_manager_;
+	gef::InputManager* platform_input_manager_;
+
+	// input record / replay
+	InputRecorder input_recorder_;
+	ScriptedInputManager* scripted_input_;
+	std::string record_filename_;
+	std::string replay_filename_;
+
+	// timestamped key events for the fixed steps, from the poller thread or, without
+	// one, from the frame polled keyboard. each step's keys go through step_input_
+	InputEventQueue input_events_;
+	InputPoller input_poller_;
+	ScriptedInputManager* step_input_;
+	bool async_input_;
+	UInt16 step_keys_;
+	UInt16 frame_keys_;
+	float step_accumulator_;
+
+	// session seed, every subsystem generator is derived from it
+	UInt32 rng_seed_;
+
+	// where new enemies go, EnemyManager's own rand() placement is overridden with these
+	SpawnQueue enemy_spawns_;
+	Random step_rand_;
+
+	gef::AudioManager* audio_manager_;
+
+	// sound effects go through the pool rather than straight to audio_manager_, so a
+	// spray of bullet contacts can't start dozens of the same sound in one step
+	SampleBank sound_bank_;
+	VoicePool sound_voices_;
+	GefAudioOutput gef_audio_output_;
+	NullAudioOutput null_audio_output_;
+	bool null_audio_;
+
+	// the CPU mixer with music streamed underneath, used instead of gef when software_audio_ is set
+	SoftwareMixer software_mixer_;
+	MusicStream music_stream_;
+	NullAudioSink null_audio_sink_;
+	WavFileSink audio_capture_;
+	bool software_audio_;
+	std::string audio_capture_filename_;
+
+	// worker threads for per-entity updates
+	JobSystem* job_system_;
+
+	// CPU copy of what's drawn, only made when use_software_renderer_ is set. each frame
+	// is copied into a packet and rasterised on the render thread with its own workers,
+	// while the main thread gets on with the next update
+	SoftwareRenderer* software_renderer_;
+	JobSystem* render_job_system_;
+	RenderThread* render_thread_;
+	RenderPacketQueue render_packets_;
+	UInt32 render_frame_;
+	bool use_software_renderer_;
+	void PublishGamePacket(const gef::Matrix44& projection_matrix, const gef::Matrix44& view_matrix);
+	void PublishSpritePacket(const gef::Sprite& background);
+	//int bullet, die, hurt;
+	
+
+	//
+	// FRONTEND DECLARATIONS
+	//
+	//gef::Texture* button_icon_;
+
+	//
+	// GAME DECLARATIONS
+	//
+	gef::Renderer3D* renderer_3d_;
+	PrimitiveBuilder* primitive_builder_;
+
+	// create the physics world
+	b2World* world_;
+
+	// player variables
+//	Player player_;
+//	b2Body* player_body_;
+
+	PlayerManager* player_one_;
+
+	// Enemy Manager
+	EnemyManager* enemy_manager_;
+
+	// bullet mananger
+
+	BulletManager* playerBullets_;
+
+	// ray cast bullets, used instead of playerBullets_ when raycast_bullets_ is set
+	ProjectileSystem projectiles_;
+	bool raycast_bullets_;
+	std::vector<GameObject*> hit_enemies_;
+	void ResolveProjectileHits();
+
+	// arena edge as a rectangle test, the wall bodies are switched off when it's in use
+	ArenaBounds arena_bounds_;
+	bool analytic_bounds_;
+	std::vector<b2Body*> bullet_bodies_;
+	std::vector<float> bullet_x_;
+	std::vector<float> bullet_y_;
+	std::vector<UInt8> bullet_outside_;
+	std::vector<float> enemy_x_;
+	std::vector<float> enemy_y_;
+	std::vector<UInt8> enemy_outside_;
+	void ApplyArenaBounds();
+
+	// recent world states, hold R in game to step back through them
+	SnapshotRing snapshots_;
+	bool RewindLevel();
+
+	// enemy steering, gathered from the world each step
+	SpatialHash enemy_grid_;
+	FlowField enemy_flow_;
+	std::vector<b2Body*> enemy_bodies_;
+	std::vector<b2Vec2> enemy_positions_;
+	std::vector<b2Vec2> enemy_steering_;
+
+	// collision category / mask per object type
+	CollisionLayers collision_layers_;
+
+	// static screens idle between changes instead of running flat out
+	FramePacer frame_pacer_;
+	float screen_active_time_;
+	bool screen_dirty_;
+	void MarkScreenActive();
+	void PaceFrame(float frame_time);
+
+	// memory by tag, see MemoryTracker
+	bool show_memory_;
+	std::string memory_report_filename_;
+
+	// physics metrics for the HUD
+	int contact_count_;
+	int touching_count_;
+	float step_time_ms_;
+
+	// ground variables
+	gef::Mesh* ground_mesh_;
+	GameObject ground_;
+	b2Body* ground_body_;
+
+	GameObject water;
+
+	// scene
+
+	gef::MeshInstance mesh_instance_;
+	gef::Scene* scene_assets_;
+
+	// model loader
+	ModelLoading* modelLoader;
+
+	// wall borders
+	Walls wallOne;
+	Walls wallTwo;
+	Walls wallThree;
+	Walls wallFour;
+
+	// audio variables
+	int sfx_id_;
+	int sfx_voice_id_;
+
+	float fps_;
+
+	GameState_ game_state_;
+	float state_timer;
+
+	// what each state runs and the assets it draws with, see kGameStates. the state the
+	// player most likely goes to next has its assets loaded in the background on entry,
+	// so changing to it only has the GPU upload left to do
+	struct GameStateInfo
+	{
+		const char* name;
+		void (SceneApp::*enter)();
+		void (SceneApp::*exit)();
+		void (SceneApp::*update)(float frame_time);
+		void (SceneApp::*render)();
+		const char* texture;
+		const char* scene;
+		GameState_ likely_next;
+	};
+	static const GameStateInfo kGameStates[NUM_GAME_STATES];
+
+	AssetPreloader asset_preloader_;
+	void EnterGameState(GameState_ new_state);
+	void PreloadGameState(GameState_ state);
+
+	// preloaded if it was asked for, otherwise loaded there and then
+	gef::Texture* LoadTexture(const char* filename);
+	gef::Scene* LoadScene(const char* filename);
+
+	// how long each change from -> to took, exit and enter together
+	struct GameStateTransition
+	{
+		UInt32 count;
+		float last_ms;
+		float max_ms;
+	};
+	GameStateTransition transitions_[NUM_GAME_STATES][NUM_GAME_STATES];
+	GameState_ last_transition_from_;
+
+	void FrontendInit();
+	void FrontendRelease();
+	void FrontendUpdate(float frame_time);
+	void FrontendRender();
+
+	void MenuInit();
+	void MenuRelease();
+	void MenuUpdate(float frame_time);
+	void MenuRender();
+
+	void SettingsInit();
+	void SettingsRelease();
+	void SettingsUpdate(float frame_time);
+	void SettingsRender();
+
+	void OverInit();
+	void OverRelease();
+	void OverUpdate(float frame_time);
+	void OverRender();
+
+	void ExitInit();
+
+	gef::Texture* main_menu;
+	gef::Texture* loader;
+	gef::Texture* settings;
+	gef::Texture* endscreen;
+
+	int selected;
+
+	void GameInit();
+	void GameRelease();
+
+	// level resources are loaded once and kept, ResetLevel just remakes the entities
+	void LevelLoad();
+	void LevelUnload();
+	void ResetLevel();
+	void ReleaseEntities();
+	bool level_loaded_;
+
+	// the level's meshes, scene data and gather buffers sit at the bottom of this up to
+	// level_arena_mark_. the managers for a play-through and what they allocate while
+	// they're built go on top and come off again in one ResetTo. the peak use is kept per
+	// difficulty to size it
+	static const int kNumDifficulties = 2;
+	LinearArena level_arena_;
+	size_t level_arena_mark_;
+	size_t level_arena_peak_[kNumDifficulties];
+	void GameUpdate(float frame_time);
+	void GameRender();
+
+	void initOcean();
+
+	/*gef::Scene* LoadSceneAssets(gef::Platform& platform, const char* filename);
+
+	gef::Mesh* GetMeshFromSceneAssets(gef::Scene* scene);
+
+	gef::Texture* CreateTextureFromPNG(const char* png_filename, gef::Platform& platform);*/
+
+	//gef::Material* mat; 
+	gef::Material* pondtex;
+	gef::Texture* pond_texture_;
+
+
+	void InitStateUpdate(float frame_time);
+	void InitStateRender();
+	
+	void GameStateInit();
+	void GameStateUpdate(float frame_time);
+	void GameStateRender();
+	void GameStateRelease();
+
+	int difficulty;
+	int finalScore;
+
+	void ChangeGameState(GameState_ new_state);
+
+	bool quitOut;
+
+};
+
+#endif // _SCENE_APP_H
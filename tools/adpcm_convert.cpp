@@ -0,0 +1,102 @@
+// converts a PCM wav to the IMA ADPCM .adp the sample bank loads, then reads it back
+// to check it: how far the decoded samples are from the wav, and how fast it decodes.
+// build with ImaAdpcm.cpp, WavFile.cpp and gef.
+//
+// usage: adpcm_convert <in.wav> <out.adp> [decode passes]
+
+#include "../ImaAdpcm.h"
+#include "../WavFile.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("usage: adpcm_convert <in.wav> <out.adp> [decode passes]\n");
+		return 1;
+	}
+
+	const char* wav_filename = argv[1];
+	const char* adp_filename = argv[2];
+	const int passes = argc > 3 ? atoi(argv[3]) : 200;
+
+	FILE* file = fopen(wav_filename, "rb");
+	WavFormat format;
+	if (!file || !ReadWavHeader(file, format))
+	{
+		printf("%s: only 8 or 16 bit PCM wav, mono or stereo\n", wav_filename);
+		if (file)
+			fclose(file);
+		return 1;
+	}
+
+	std::vector<UInt8> pcm(format.data_size);
+	if (!pcm.empty())
+		pcm.resize(fread(&pcm[0], 1, pcm.size(), file));
+	fclose(file);
+
+	AdpcmHeader header;
+	header.channels = format.channels;
+	header.block_frames = (UInt16)kAdpcmBlockFrames;
+	header.sample_rate = format.sample_rate;
+	header.frame_count = (UInt32)pcm.size() / format.bytes_per_frame();
+
+	if (header.frame_count == 0)
+	{
+		printf("%s has no samples\n", wav_filename);
+		return 1;
+	}
+
+	const UInt32 sample_count = header.frame_count * header.channels;
+	std::vector<Int16> original(sample_count);
+	DecodePCM(&pcm[0], sample_count, format.bits_per_sample, &original[0]);
+
+	std::vector<UInt8> encoded;
+	EncodeAdpcm(&original[0], header.frame_count, header.channels, header.block_frames, encoded);
+	if (!WriteAdpcmFile(adp_filename, header, encoded))
+	{
+		printf("could not write %s\n", adp_filename);
+		return 1;
+	}
+
+	// check what was written, not what's still in memory
+	AdpcmHeader read_header;
+	std::vector<UInt8> read_data;
+	if (!ReadAdpcmFile(adp_filename, read_header, read_data))
+	{
+		printf("could not read %s back\n", adp_filename);
+		return 1;
+	}
+
+	std::vector<Int16> decoded(sample_count);
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	for (int pass = 0; pass < passes; ++pass)
+		DecodeAdpcm(&read_data[0], read_header.frame_count, read_header.channels, read_header.block_frames, &decoded[0]);
+	const std::chrono::duration<double> decode_time = std::chrono::high_resolution_clock::now() - start;
+
+	double error_squared = 0.0, signal_squared = 0.0;
+	int peak_error = 0;
+	for (UInt32 sample_num = 0; sample_num < sample_count; ++sample_num)
+	{
+		const int error = abs((int)decoded[sample_num] - (int)original[sample_num]);
+		error_squared += (double)error * error;
+		signal_squared += (double)original[sample_num] * original[sample_num];
+		if (error > peak_error)
+			peak_error = error;
+	}
+
+	const double rms_error = sqrt(error_squared / sample_count);
+	const double snr = error_squared > 0.0 ? 10.0 * log10(signal_squared / error_squared) : 999.0;
+	const double samples_per_second = (double)sample_count * passes / decode_time.count();
+
+	printf("%s: %u frames, %u channels, %u Hz\n", wav_filename, header.frame_count, header.channels, header.sample_rate);
+	printf("size %u -> %u bytes (%.1f%%)\n", (UInt32)pcm.size(), (UInt32)(encoded.size() + 16), 100.0 * (encoded.size() + 16) / pcm.size());
+	printf("error rms %.1f peak %d, snr %.1f dB\n", rms_error, peak_error, snr);
+	printf("decode %.1f M samples/s, %.0fx real time\n", samples_per_second / 1.0e6, samples_per_second / ((double)header.sample_rate * header.channels));
+
+	return 0;
+}
@@ -0,0 +1,171 @@
+// synthetic key taps fed through the fixed step loop two ways: the old frame polled
+// keys, where every step in a frame sees the keys as they were at the frame's start,
+// and the timestamped InputEventQueue, where each step takes what came in before its
+// end and the frame's last step takes everything up to the frame's start. reports
+// taps missed and the wall clock latency from the press to the frame that runs the
+// step first seeing it, at frame rates below, at and above the step rate. the queue
+// should never be later than polling, what it adds is the taps released before the
+// frame polls that it still catches. returns non-zero if the queue misses a tap, sees
+// any tap in a later frame than polling does, or comes out slower on mean or max.
+// build with InputEventQueue.cpp and gef.
+//
+// usage: input_latency_test [taps]
+
+#include "../InputEventQueue.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <vector>
+
+static const double kFixedStep = 1.0 / 60.0;
+static const int kKey = 0;
+
+struct Tap
+{
+	double down;
+	double up;
+};
+
+struct Result
+{
+	int missed;
+	double total_latency;
+	double max_latency;
+	int later;
+};
+
+// per tap, seconds from the press to the start of the frame that ran the step first
+// seeing it, which is as soon as the game can act on it. negative if it was missed
+typedef std::vector<double> Latencies;
+
+// latency is only compared over the taps both ways saw, a missed tap has none.
+// later counts the taps seen in a later frame than other saw them in
+static void Summarise(const Latencies& latencies, const Latencies& other, Result& result, int& compared)
+{
+	result = Result();
+	compared = 0;
+	for (size_t tap = 0; tap < latencies.size(); ++tap)
+	{
+		if (latencies[tap] < 0.0)
+		{
+			result.missed++;
+			continue;
+		}
+
+		if (other[tap] < 0.0)
+			continue;
+
+		compared++;
+		result.total_latency += latencies[tap];
+		result.max_latency = std::max(result.max_latency, latencies[tap]);
+		if (latencies[tap] > other[tap])
+			result.later++;
+	}
+}
+
+static void Run(const std::vector<Tap>& taps, double frame_time, double end_time, Latencies& polled, Latencies& queued)
+{
+	polled.assign(taps.size(), -1.0);
+	queued.assign(taps.size(), -1.0);
+
+	InputEventQueue queue;
+	size_t next_event = 0;
+	std::vector<InputEvent> events;
+	for (size_t tap = 0; tap < taps.size(); ++tap)
+	{
+		InputEvent down = { taps[tap].down, (UInt8)kKey, true };
+		InputEvent up = { taps[tap].up, (UInt8)kKey, false };
+		events.push_back(down);
+		events.push_back(up);
+	}
+
+	UInt16 queued_keys = 0;
+	double accumulator = 0.0;
+
+	for (double now = frame_time; now < end_time; now += frame_time)
+	{
+		// everything up to the frame's start reaches the queue, as the poller thread would push it
+		while (next_event < events.size() && events[next_event].time <= now)
+			queue.Push(events[next_event++]);
+
+		// the frame polled key is whatever state it's in right now
+		int polled_tap = -1;
+		for (size_t tap = 0; tap < taps.size(); ++tap)
+		{
+			if (taps[tap].down <= now && now < taps[tap].up)
+				polled_tap = (int)tap;
+		}
+
+		// same split as GameUpdate, the last step runs up to now
+		accumulator += frame_time;
+		const int steps = (int)(accumulator / kFixedStep);
+		accumulator -= steps * kFixedStep;
+		for (int step = 0; step < steps; ++step)
+		{
+			const double step_end = step == steps - 1 ? now : now - accumulator - (steps - 1 - step) * kFixedStep;
+
+			if (polled_tap >= 0 && polled[polled_tap] < 0.0)
+				polled[polled_tap] = now - taps[polled_tap].down;
+
+			UInt16 previous = queued_keys;
+			queue.Apply(step_end, queued_keys);
+			if ((queued_keys & ~previous) & (1 << kKey))
+			{
+				// the latest tap pressed by now is the one this step saw go down
+				for (size_t tap = taps.size(); tap-- > 0;)
+				{
+					if (taps[tap].down <= step_end && queued[tap] < 0.0)
+					{
+						queued[tap] = now - taps[tap].down;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const int tap_count = argc > 1 ? atoi(argv[1]) : 2000;
+
+	// taps from 5ms to 120ms long, a third of a second or so apart
+	srand(1);
+	std::vector<Tap> taps;
+	double time = 0.1;
+	for (int tap = 0; tap < tap_count; ++tap)
+	{
+		Tap new_tap;
+		new_tap.down = time + (rand() % 1000) / 1000.0 * 0.1;
+		new_tap.up = new_tap.down + 0.005 + (rand() % 1000) / 1000.0 * 0.115;
+		taps.push_back(new_tap);
+		time = new_tap.up + 0.2 + (rand() % 1000) / 1000.0 * 0.1;
+	}
+
+	bool passed = true;
+	const double frame_rates[] = { 30.0, 60.0, 144.0 };
+	for (int rate = 0; rate < 3; ++rate)
+	{
+		Latencies polled_latencies, queued_latencies;
+		Run(taps, 1.0 / frame_rates[rate], time + 1.0, polled_latencies, queued_latencies);
+
+		Result polled, queued;
+		int compared = 0;
+		Summarise(polled_latencies, queued_latencies, polled, compared);
+		Summarise(queued_latencies, polled_latencies, queued, compared);
+
+		printf("%3.0f fps  polled: %4d missed, latency mean %5.2fms max %5.2fms\n", frame_rates[rate], polled.missed,
+			compared ? polled.total_latency / compared * 1000.0 : 0.0, polled.max_latency * 1000.0);
+		printf("         queued: %4d missed, latency mean %5.2fms max %5.2fms (over the %d taps both saw), %d later than polled\n",
+			queued.missed, compared ? queued.total_latency / compared * 1000.0 : 0.0, queued.max_latency * 1000.0, compared, queued.later);
+
+		if (queued.missed > 0 || queued.later > 0 || queued.total_latency > polled.total_latency || queued.max_latency > polled.max_latency)
+		{
+			printf("         FAILED\n");
+			passed = false;
+		}
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+// headless timing of the two jobs the game spreads over JobSystem, at 1, 2, 4 and 8
+// threads. steering is what SteerEnemies does once the enemies are gathered: grid
+// build, then separation and a flow field sample per enemy in parallel. bullets are
+// ProjectileSystem's ray casts against a bare world of static enemies, topped back up
+// every step like projectile_benchmark. the numbers are the per step cost of each and
+// the speed up over one thread.
+// build with JobSystem.cpp, SpatialHash.cpp, FlowField.cpp, ProjectileSystem.cpp,
+// ArenaBounds.cpp, CollisionLayers.cpp, Random.cpp, RenderPacket.cpp, game_object.cpp,
+// box2d and gef.
+//
+// usage: job_scaling_benchmark [steps] [enemies] [bullets]
+
+#include "../JobSystem.h"
+#include "../SpatialHash.h"
+#include "../FlowField.h"
+#include "../ProjectileSystem.h"
+#include "../ArenaBounds.h"
+#include "../CollisionLayers.h"
+#include "../Random.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <vector>
+
+static const float kStepTime = 1.0f / 60.0f;
+static const float kHalfWidth = 35.0f;
+static const float kHalfHeight = 25.0f;
+
+// the game's steering setup, see scene_app.cpp
+static const float kSeparationRadius = 2.0f;
+static const float kSeparationStrength = 3.0f;
+static const float kFlowCellSize = 1.0f;
+static const float kEnemySpeed = 6.0f;
+static const int kSteeringGrain = 256;
+static const int kStaticEnemyCount = 50;
+
+static b2Vec2 RandomPosition(Random& random)
+{
+	return b2Vec2(random.Range(-kHalfWidth, kHalfWidth), random.Range(-kHalfHeight, kHalfHeight));
+}
+
+static b2Vec2 RandomDirection(Random& random)
+{
+	const float angle = random.Range(0.0f, 6.2831853f);
+	return b2Vec2(cosf(angle), sinf(angle));
+}
+
+// enemies move by their own steering each step, so the grid and field see a changing crowd
+static float RunSteering(int enemy_count, int steps, JobSystem* job_system)
+{
+	Random random(1);
+	SpatialHash grid;
+	grid.Init(kHalfWidth, kHalfHeight, kSeparationRadius);
+	FlowField flow;
+	flow.Init(kHalfWidth, kHalfHeight, kFlowCellSize);
+
+	std::vector<b2Vec2> positions(enemy_count);
+	std::vector<b2Vec2> steering(enemy_count);
+	for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+		positions[enemy_num] = RandomPosition(random);
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	for (int step = 0; step < steps; ++step)
+	{
+		// the player walks a circle so the target keeps changing cell
+		const float angle = step * kStepTime;
+		flow.SetTarget(b2Vec2(15.0f * cosf(angle), 10.0f * sinf(angle)));
+
+		grid.Build(&positions[0], enemy_count);
+
+		job_system->ParallelFor(enemy_count, kSteeringGrain, [&](int begin, int end)
+		{
+			grid.ComputeSeparation(kSeparationRadius, kSeparationStrength, &steering[0], begin, end);
+
+			for (int enemy_num = begin; enemy_num < end; ++enemy_num)
+				steering[enemy_num] += kEnemySpeed * flow.Sample(positions[enemy_num]);
+		});
+
+		// stands in for box2d moving them
+		for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+			positions[enemy_num] += kStepTime * steering[enemy_num];
+	}
+
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / steps;
+}
+
+static float RunBullets(int bullet_count, int steps, JobSystem* job_system)
+{
+	Random random(1);
+	CollisionLayers layers;
+	layers.Init(true);
+	ArenaBounds bounds;
+	bounds.Init(kHalfWidth, kHalfHeight);
+
+	b2World world(b2Vec2(0.0f, 0.0f));
+
+	// static enemies for the rays to hit, their GameObjects only give them a type
+	std::vector<GameObject> enemies(kStaticEnemyCount);
+	b2PolygonShape shape;
+	shape.SetAsBox(0.5f, 0.5f);
+
+	b2FixtureDef fixture_def;
+	fixture_def.shape = &shape;
+	fixture_def.filter = layers.FilterFor(ENEMY);
+
+	for (int enemy_num = 0; enemy_num < kStaticEnemyCount; ++enemy_num)
+	{
+		enemies[enemy_num].set_type(ENEMY);
+
+		b2BodyDef body_def;
+		body_def.type = b2_staticBody;
+		body_def.position = RandomPosition(random);
+		body_def.userData.pointer = reinterpret_cast<uintptr_t>(&enemies[enemy_num]);
+
+		world.CreateBody(&body_def)->CreateFixture(&fixture_def);
+	}
+
+	ProjectileSystem projectiles;
+	projectiles.Init(bullet_count, NULL);
+
+	float update_ms = 0.0f;
+	for (int step = 0; step < steps; ++step)
+	{
+		while (projectiles.live_count() < bullet_count)
+			projectiles.Fire(RandomPosition(random), RandomDirection(random));
+
+		// only the update is timed, topping up and retiring stay on the main thread
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		projectiles.Update(kStepTime, &world, job_system);
+		update_ms += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		projectiles.RetireOutside(bounds);
+	}
+
+	return update_ms / steps;
+}
+
+int main(int argc, char** argv)
+{
+	const int steps = argc > 1 ? atoi(argv[1]) : 300;
+	const int enemy_count = argc > 2 ? atoi(argv[2]) : 5000;
+	const int bullet_count = argc > 3 ? atoi(argv[3]) : 10000;
+
+	printf("%d steps, %d steering enemies, %d bullets, %u hardware threads\n", steps, enemy_count, bullet_count, std::thread::hardware_concurrency());
+	printf("threads   steering: ms/step speed up   bullets: ms/step speed up\n");
+
+	float steering_one = 0.0f;
+	float bullets_one = 0.0f;
+
+	const int thread_counts[] = { 1, 2, 4, 8 };
+	for (int count_num = 0; count_num < 4; ++count_num)
+	{
+		JobSystem job_system(thread_counts[count_num]);
+
+		const float steering_ms = RunSteering(enemy_count, steps, &job_system);
+		const float bullets_ms = RunBullets(bullet_count, steps, &job_system);
+
+		if (count_num == 0)
+		{
+			steering_one = steering_ms;
+			bullets_one = bullets_ms;
+		}
+
+		printf("%7d   %17.3f %8.2fx   %16.3f %8.2fx\n", job_system.thread_count(),
+			steering_ms, steering_one / steering_ms, bullets_ms, bullets_one / bullets_ms);
+	}
+
+	return 0;
+}
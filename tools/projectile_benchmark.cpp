@@ -0,0 +1,259 @@
+// headless timing of the two bullet modes against a bare world of static enemies.
+// rigid body bullets are pooled circle bodies stepped by box2d, as BulletManager's are;
+// ray cast bullets go through ProjectileSystem. either way the live count is topped
+// back up every step, so the step always has that many bullets in flight.
+// the rigid body bullets are run twice, retired by the arena bounds test and by
+// contacts with four wall bodies (the game's -wall-bodies), to compare the two.
+// build with ProjectileSystem.cpp, JobSystem.cpp, ArenaBounds.cpp, CollisionLayers.cpp,
+// Random.cpp, RenderPacket.cpp, game_object.cpp, box2d and gef.
+//
+// usage: projectile_benchmark [steps]
+
+#include "../ProjectileSystem.h"
+#include "../JobSystem.h"
+#include "../ArenaBounds.h"
+#include "../CollisionLayers.h"
+#include "../Random.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <vector>
+
+static const float kStepTime = 1.0f / 60.0f;
+static const float kHalfWidth = 35.0f;
+static const float kHalfHeight = 25.0f;
+static const float kBulletSpeed = 30.0f;
+static const float kBulletRadius = 0.25f;
+static const int kEnemyCount = 50;
+
+struct Result
+{
+	float step_ms;
+	int hits;
+	int contacts;
+};
+
+// enemies as static boxes, their GameObjects only give the bullets a type to test
+static void AddEnemies(b2World& world, std::vector<GameObject>& enemies, const CollisionLayers& layers, Random& random)
+{
+	b2PolygonShape shape;
+	shape.SetAsBox(0.5f, 0.5f);
+
+	b2FixtureDef fixture_def;
+	fixture_def.shape = &shape;
+	fixture_def.filter = layers.FilterFor(ENEMY);
+
+	for (size_t enemy_num = 0; enemy_num < enemies.size(); ++enemy_num)
+	{
+		enemies[enemy_num].set_type(ENEMY);
+
+		b2BodyDef body_def;
+		body_def.type = b2_staticBody;
+		body_def.position.Set(random.Range(-kHalfWidth, kHalfWidth), random.Range(-kHalfHeight, kHalfHeight));
+		body_def.userData.pointer = reinterpret_cast<uintptr_t>(&enemies[enemy_num]);
+
+		world.CreateBody(&body_def)->CreateFixture(&fixture_def);
+	}
+}
+
+static b2Vec2 RandomDirection(Random& random)
+{
+	const float angle = random.Range(0.0f, 6.2831853f);
+	return b2Vec2(cosf(angle), sinf(angle));
+}
+
+static b2Vec2 RandomPosition(Random& random)
+{
+	return b2Vec2(random.Range(-kHalfWidth, kHalfWidth), random.Range(-kHalfHeight, kHalfHeight));
+}
+
+// the arena edge as the game's walls had it, static boxes just outside
+static void AddWalls(b2World& world, std::vector<GameObject>& walls, const CollisionLayers& layers)
+{
+	const b2Vec2 centres[4] = { b2Vec2(0.0f, kHalfHeight + 1.0f), b2Vec2(0.0f, -kHalfHeight - 1.0f),
+		b2Vec2(kHalfWidth + 1.0f, 0.0f), b2Vec2(-kHalfWidth - 1.0f, 0.0f) };
+
+	for (int wall_num = 0; wall_num < 4; ++wall_num)
+	{
+		walls[wall_num].set_type(WALL);
+
+		b2PolygonShape shape;
+		if (wall_num < 2)
+			shape.SetAsBox(kHalfWidth + 2.0f, 1.0f);
+		else
+			shape.SetAsBox(1.0f, kHalfHeight + 2.0f);
+
+		b2FixtureDef fixture_def;
+		fixture_def.shape = &shape;
+		fixture_def.filter = layers.FilterFor(WALL);
+
+		b2BodyDef body_def;
+		body_def.type = b2_staticBody;
+		body_def.position = centres[wall_num];
+		body_def.userData.pointer = reinterpret_cast<uintptr_t>(&walls[wall_num]);
+
+		world.CreateBody(&body_def)->CreateFixture(&fixture_def);
+	}
+}
+
+static Result RunBodies(int bullet_count, int steps, bool wall_bodies)
+{
+	Random random(1);
+	CollisionLayers layers;
+	layers.Init(true);
+	ArenaBounds bounds;
+	bounds.Init(kHalfWidth, kHalfHeight);
+
+	b2World world(b2Vec2(0.0f, 0.0f));
+	std::vector<GameObject> enemies(kEnemyCount);
+	AddEnemies(world, enemies, layers, random);
+
+	std::vector<GameObject> walls(4);
+	if (wall_bodies)
+		AddWalls(world, walls, layers);
+
+	// the pool, every bullet is live from the start and recycled in place
+	std::vector<GameObject> bullet_objects(bullet_count);
+	std::vector<b2Body*> bullets(bullet_count);
+
+	b2CircleShape shape;
+	shape.m_radius = kBulletRadius;
+
+	b2FixtureDef fixture_def;
+	fixture_def.shape = &shape;
+	fixture_def.density = 1.0f;
+	fixture_def.filter = layers.FilterFor(BULLET);
+
+	for (int bullet_num = 0; bullet_num < bullet_count; ++bullet_num)
+	{
+		bullet_objects[bullet_num].set_type(BULLET);
+
+		b2BodyDef body_def;
+		body_def.type = b2_dynamicBody;
+		body_def.position = RandomPosition(random);
+		body_def.userData.pointer = reinterpret_cast<uintptr_t>(&bullet_objects[bullet_num]);
+
+		bullets[bullet_num] = world.CreateBody(&body_def);
+		bullets[bullet_num]->CreateFixture(&fixture_def);
+		bullets[bullet_num]->SetLinearVelocity(kBulletSpeed * RandomDirection(random));
+	}
+
+	std::vector<float> xs(bullet_count), ys(bullet_count);
+	std::vector<UInt8> outside(bullet_count), spent(bullet_count);
+
+	Result result = { 0.0f, 0, 0 };
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	for (int step = 0; step < steps; ++step)
+	{
+		world.Step(kStepTime, 6, 2);
+
+		// what the contact walk in UpdateSimulation does for bullets
+		for (int bullet_num = 0; bullet_num < bullet_count; ++bullet_num)
+			spent[bullet_num] = 0;
+
+		for (b2Contact* contact = world.GetContactList(); contact; contact = contact->GetNext())
+		{
+			result.contacts++;
+			if (!contact->IsTouching())
+				continue;
+
+			GameObject* a = reinterpret_cast<GameObject*>(contact->GetFixtureA()->GetBody()->GetUserData().pointer);
+			GameObject* b = reinterpret_cast<GameObject*>(contact->GetFixtureB()->GetBody()->GetUserData().pointer);
+			GameObject* bullet = a->type() == BULLET ? a : (b->type() == BULLET ? b : NULL);
+			if (bullet)
+			{
+				spent[bullet - &bullet_objects[0]] = 1;
+				if ((bullet == a ? b : a)->type() == ENEMY)
+					result.hits++;
+			}
+		}
+
+		// with wall bodies the contacts above have already caught the ones at the edge
+		if (!wall_bodies)
+		{
+			for (int bullet_num = 0; bullet_num < bullet_count; ++bullet_num)
+			{
+				xs[bullet_num] = bullets[bullet_num]->GetPosition().x;
+				ys[bullet_num] = bullets[bullet_num]->GetPosition().y;
+			}
+			bounds.TestOutside(&xs[0], &ys[0], bullet_count, &outside[0]);
+		}
+
+		// spent ones go back out from somewhere new, moving a body is what a pool reuse costs
+		for (int bullet_num = 0; bullet_num < bullet_count; ++bullet_num)
+		{
+			if (spent[bullet_num] || outside[bullet_num])
+			{
+				bullets[bullet_num]->SetTransform(RandomPosition(random), 0.0f);
+				bullets[bullet_num]->SetLinearVelocity(kBulletSpeed * RandomDirection(random));
+			}
+		}
+	}
+
+	result.step_ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / steps;
+	result.contacts /= steps;
+	return result;
+}
+
+static Result RunRayCasts(int bullet_count, int steps, JobSystem* job_system)
+{
+	Random random(1);
+	CollisionLayers layers;
+	layers.Init(true);
+	ArenaBounds bounds;
+	bounds.Init(kHalfWidth, kHalfHeight);
+
+	b2World world(b2Vec2(0.0f, 0.0f));
+	std::vector<GameObject> enemies(kEnemyCount);
+	AddEnemies(world, enemies, layers, random);
+
+	ProjectileSystem projectiles;
+	projectiles.Init(bullet_count, NULL);
+
+	Result result = { 0.0f, 0, 0 };
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	for (int step = 0; step < steps; ++step)
+	{
+		while (projectiles.live_count() < bullet_count)
+			projectiles.Fire(RandomPosition(random), RandomDirection(random));
+
+		projectiles.Update(kStepTime, &world, job_system);
+		result.hits += (int)projectiles.hits().size();
+		projectiles.RetireOutside(bounds);
+
+		// the enemies are static so box2d has nothing to do, it's stepped to match the game
+		world.Step(kStepTime, 6, 2);
+		result.contacts += world.GetContactCount();
+	}
+
+	result.step_ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / steps;
+	result.contacts /= steps;
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	const int steps = argc > 1 ? atoi(argv[1]) : 300;
+
+	JobSystem job_system;
+
+	printf("%d static enemies, %d steps, %d job threads\n", kEnemyCount, steps, job_system.thread_count());
+	printf("bullets   wall bodies: ms/step contacts   bodies: ms/step contacts hits   ray casts: ms/step hits\n");
+
+	const int bullet_counts[] = { 100, 1000, 10000 };
+	for (int count_num = 0; count_num < 3; ++count_num)
+	{
+		const int bullet_count = bullet_counts[count_num];
+		const Result walls = RunBodies(bullet_count, steps, true);
+		const Result bodies = RunBodies(bullet_count, steps, false);
+		const Result ray_casts = RunRayCasts(bullet_count, steps, &job_system);
+
+		printf("%7d   %20.3f %8d   %15.3f %8d %5d   %18.3f %5d\n", bullet_count, walls.step_ms, walls.contacts,
+			bodies.step_ms, bodies.contacts, bodies.hits, ray_casts.step_ms, ray_casts.hits);
+	}
+
+	return 0;
+}
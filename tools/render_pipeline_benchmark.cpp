@@ -0,0 +1,100 @@
+// headless timing of the software render path, with the update and the rasterising
+// back to back on one thread and then overlapped through the render thread.
+// build with RenderPacket.cpp, RenderThread.cpp, SoftwareRenderer.cpp, JobSystem.cpp and gef.
+//
+// usage: render_pipeline_benchmark [objects] [frames]
+
+#include "../RenderPacket.h"
+#include "../RenderThread.h"
+#include "../SoftwareRenderer.h"
+#include "../JobSystem.h"
+#include <maths/math_utils.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <thread>
+
+static const int kWidth = 960;
+static const int kHeight = 544;
+
+// stands in for the game update, objects circle the origin with some busy work per object
+static void Simulate(int frame, int object_count, std::vector<float>& xs, std::vector<float>& ys)
+{
+	for (int i = 0; i < object_count; ++i)
+	{
+		float angle = (float)frame * 0.01f + (float)i * 0.1f;
+		float radius = 5.0f + (float)(i % 20);
+		for (int step = 0; step < 64; ++step)
+			angle += sinf(angle) * 0.0001f;
+
+		xs[i] = cosf(angle) * radius;
+		ys[i] = sinf(angle) * radius;
+	}
+}
+
+static void FillPacket(RenderPacket& packet, int frame, const std::vector<float>& xs, const std::vector<float>& ys)
+{
+	packet.frame = (UInt32)frame;
+	packet.clear_colour = 0xff0a0c0c;
+	packet.projection_matrix.PerspectiveFovD3D(gef::DegToRad(45.0f), (float)kWidth / (float)kHeight, 0.1f, 100.0f);
+	packet.view_matrix.LookAt(gef::Vector4(0.0f, -10.0f, 50.0f), gef::Vector4(0.0f, 0.0f, 0.0f), gef::Vector4(0.0f, 1.0f, 0.0f));
+
+	RenderObject object;
+	object.min = gef::Vector4(-0.5f, -0.5f, -0.5f);
+	object.max = gef::Vector4(0.5f, 0.5f, 0.5f);
+	object.colour = 0xff2020e0;
+	for (size_t i = 0; i < xs.size(); ++i)
+	{
+		object.transform.SetIdentity();
+		object.transform.SetTranslation(gef::Vector4(xs[i], ys[i], 0.0f));
+		packet.objects.push_back(object);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const int object_count = argc > 1 ? atoi(argv[1]) : 2000;
+	const int frame_count = argc > 2 ? atoi(argv[2]) : 300;
+
+	std::vector<float> xs(object_count), ys(object_count);
+
+	JobSystem render_jobs(std::max(1, (int)std::thread::hardware_concurrency() / 2));
+	SoftwareRenderer renderer(kWidth, kHeight, &render_jobs);
+
+	// serial, update then draw
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	RenderPacket packet;
+	for (int frame = 0; frame < frame_count; ++frame)
+	{
+		Simulate(frame, object_count, xs, ys);
+		packet.Clear();
+		FillPacket(packet, frame, xs, ys);
+		RenderThread::Draw(&renderer, packet);
+	}
+	const std::chrono::duration<double> serial = std::chrono::high_resolution_clock::now() - start;
+
+	// pipelined, frame n + 1 updates while frame n rasterises
+	RenderPacketQueue queue;
+	RenderThread render_thread(&renderer, &queue);
+	render_thread.Start();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int frame = 0; frame < frame_count; ++frame)
+	{
+		Simulate(frame, object_count, xs, ys);
+		RenderPacket* queued = queue.BeginWrite();
+		FillPacket(*queued, frame, xs, ys);
+		queue.EndWrite();
+	}
+	queue.Flush();
+	const std::chrono::duration<double> pipelined = std::chrono::high_resolution_clock::now() - start;
+	render_thread.Stop();
+
+	printf("%d objects, %d frames, %d raster threads\n", object_count, frame_count, render_jobs.thread_count());
+	printf("serial:    %8.2f fps  %6.2f ms/frame\n", frame_count / serial.count(), serial.count() * 1000.0 / frame_count);
+	printf("pipelined: %8.2f fps  %6.2f ms/frame  (%u frames drawn)\n", frame_count / pipelined.count(), pipelined.count() * 1000.0 / frame_count, render_thread.frames_drawn());
+
+	return 0;
+}
@@ -0,0 +1,248 @@
+// headless restart loop over a stand-in level: a manager newed into a LinearArena
+// owning pooled bodies, played for a few steps and restarted, over and over. restarts
+// remake it the way ResetLevel does (manager deleted, arena ResetTo, bodies destroyed
+// and created again). reports RSS and arena use, and returns non-zero if a rebuilt
+// manager isn't fresh, the arena doesn't come back to the same use or RSS keeps growing.
+// build with LinearArena.cpp, MemoryTracker.cpp, box2d and gef.
+//
+// usage: restart_cycle_test [restarts]
+
+#include <box2d/Box2D.h>
+#include "../LinearArena.h"
+#include "../MemoryTracker.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+static const float kStepTime = 1.0f / 60.0f;
+static const int kEntityCount = 64;
+static const int kStepsPerPlay = 120;
+static const int kWarmUpRestarts = 20;
+static const size_t kArenaSize = 256 * 1024;
+static const size_t kLevelBytes = 16 * 1024;
+
+// allowed RSS growth between the end of warm up and the last restart
+static const size_t kRssSlack = 256 * 1024;
+
+static size_t ResidentBytes()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.WorkingSetSize;
+#else
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (!file)
+		return 0;
+
+	unsigned long size_pages = 0, resident_pages = 0;
+	const int read = fscanf(file, "%lu %lu", &size_pages, &resident_pages);
+	fclose(file);
+
+	return read == 2 ? resident_pages * (size_t)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+struct Entity
+{
+	b2Body* body;
+	bool dead;
+	float timer;
+};
+
+// what the game's managers look like from outside: state in members, a container that
+// grows during play, and bodies it creates but leaves in the world when it's deleted
+class StandInManager
+{
+public:
+	StandInManager(b2World* world) :
+		score_(0),
+		next_kill_(0)
+	{
+		b2CircleShape shape;
+		shape.m_radius = 0.5f;
+
+		b2FixtureDef fixture_def;
+		fixture_def.shape = &shape;
+		fixture_def.density = 1.0f;
+
+		entities_.resize(kEntityCount);
+		for (int entity_num = 0; entity_num < kEntityCount; ++entity_num)
+		{
+			b2BodyDef body_def;
+			body_def.type = b2_dynamicBody;
+			body_def.position.Set((float)(entity_num % 8) * 2.0f, (float)(entity_num / 8) * 2.0f);
+			body_def.userData.pointer = reinterpret_cast<uintptr_t>(&entities_[entity_num]);
+
+			entities_[entity_num].body = world->CreateBody(&body_def);
+			entities_[entity_num].body->CreateFixture(&fixture_def);
+			entities_[entity_num].dead = false;
+			entities_[entity_num].timer = 0.0f;
+		}
+	}
+
+	void Update(float frame_time)
+	{
+		for (size_t entity_num = 0; entity_num < entities_.size(); ++entity_num)
+		{
+			Entity& entity = entities_[entity_num];
+			if (entity.dead)
+				continue;
+
+			entity.timer += frame_time;
+			entity.body->SetLinearVelocity(b2Vec2(1.0f, 0.5f));
+		}
+
+		// one kill every few steps, the list grows like the managers' containers do
+		if (++next_kill_ % 4 == 0)
+		{
+			const int victim = (next_kill_ / 4) % kEntityCount;
+			if (!entities_[victim].dead)
+			{
+				entities_[victim].dead = true;
+				entities_[victim].body->SetEnabled(false);
+				killed_.push_back(victim);
+				score_ += 10;
+			}
+		}
+	}
+
+	// the state a fresh manager has
+	bool IsFresh() const
+	{
+		if (score_ != 0 || next_kill_ != 0 || !killed_.empty())
+			return false;
+
+		for (size_t entity_num = 0; entity_num < entities_.size(); ++entity_num)
+		{
+			const Entity& entity = entities_[entity_num];
+			if (entity.dead || entity.timer != 0.0f || !entity.body->IsEnabled())
+				return false;
+		}
+
+		return true;
+	}
+
+private:
+	std::vector<Entity> entities_;
+	std::vector<int> killed_;
+	int score_;
+	int next_kill_;
+};
+
+struct Level
+{
+	b2World* world;
+	LinearArena arena;
+	size_t arena_mark;
+	StandInManager* manager;
+};
+
+static void DestroyBodies(b2World* world)
+{
+	b2Body* body = world->GetBodyList();
+	while (body)
+	{
+		b2Body* next = body->GetNext();
+		world->DestroyBody(body);
+		body = next;
+	}
+}
+
+// what ResetLevel does
+static void Rebuild(Level& level)
+{
+	level.arena.Delete(level.manager);
+	level.arena.ResetTo(level.arena_mark);
+	DestroyBodies(level.world);
+
+	MemoryArenaScope level_scope(&level.arena);
+	level.manager = level.arena.New<StandInManager>(level.world);
+}
+
+static void Play(Level& level)
+{
+	MemoryTagScope gameplay_tag(MEMORY_TAG_GAMEPLAY);
+
+	for (int step = 0; step < kStepsPerPlay; ++step)
+	{
+		// only construction goes in the arena, like ResetLevel
+		level.manager->Update(kStepTime);
+
+		level.world->Step(kStepTime, 6, 2);
+	}
+}
+
+// returns false if anything failed
+static bool Run(int restarts)
+{
+	MemoryTagScope gameplay_tag(MEMORY_TAG_GAMEPLAY);
+
+	Level level;
+	level.world = new b2World(b2Vec2(0.0f, 0.0f));
+	level.arena.Init(kArenaSize);
+
+	// stands in for the level's meshes and scene data below the mark
+	level.arena.Alloc(kLevelBytes, 16);
+	level.arena_mark = level.arena.used();
+	level.manager = NULL;
+
+	Rebuild(level);
+	const size_t built_used = level.arena.used();
+
+	bool ok = true;
+	int dirty_rebuilds = 0;
+	size_t warm_rss = 0;
+
+	for (int restart = 0; restart < kWarmUpRestarts + restarts; ++restart)
+	{
+		if (restart == kWarmUpRestarts)
+		{
+			warm_rss = ResidentBytes();
+		}
+
+		Play(level);
+		Rebuild(level);
+
+		if (!level.manager->IsFresh() || level.arena.used() != built_used)
+			dirty_rebuilds++;
+	}
+
+	const size_t end_rss = ResidentBytes();
+
+	printf("RSS %7u KB -> %7u KB, arena %u used, peak %u, %u overflowed, %d rebuilds not fresh\n",
+		(UInt32)(warm_rss / 1024), (UInt32)(end_rss / 1024), (UInt32)level.arena.used(),
+		(UInt32)level.arena.high_water_mark(), (UInt32)level.arena.overflow_bytes(), dirty_rebuilds);
+
+	if (dirty_rebuilds > 0)
+		ok = false;
+
+	if (end_rss > warm_rss + kRssSlack)
+	{
+		printf("  RSS grew by %u KB\n", (UInt32)((end_rss - warm_rss) / 1024));
+		ok = false;
+	}
+
+	level.arena.Delete(level.manager);
+	delete level.world;
+	level.arena.Release();
+
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	const int restarts = argc > 1 ? atoi(argv[1]) : 1000;
+
+	printf("%d restarts after %d to warm up, %d entities, %d steps each\n", restarts, kWarmUpRestarts, kEntityCount, kStepsPerPlay);
+
+	return Run(restarts) ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+// headless timing of the software mixer. keeps the voice pool full of sound effects
+// at 60 updates a second, with music streaming underneath if a wav is given, and
+// mixes to the null sink or to a wav file to listen to. with music the updates are
+// paced to real time, the reader thread only keeps up with a mixer running at the
+// rate it plays at, so the underrun count means what it does in the game.
+// build with SoftwareMixer.cpp, MusicStream.cpp, VoicePool.cpp, SampleBank.cpp,
+// WavFile.cpp, ImaAdpcm.cpp, MemoryTracker.cpp, LinearArena.cpp and gef.
+//
+// usage: software_mixer_benchmark [voices] [seconds] [music.wav] [out.wav]
+
+#include "../SoftwareMixer.h"
+#include "../MusicStream.h"
+#include "../SampleBank.h"
+#include "../MemoryTracker.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <thread>
+#include <vector>
+
+static const float kStepTime = 1.0f / 60.0f;
+
+// a decaying tone at a rate other than the output's, so every voice resamples
+static int AddTone(SampleBank& bank, const char* name, float frequency, UInt32 sample_rate)
+{
+	const SampleLimits limits = { VoicePool::kMaxVoices, 0.0f, 1 };
+
+	std::vector<Int16> frames(sample_rate / 2);
+	for (size_t frame = 0; frame < frames.size(); ++frame)
+	{
+		const float t = (float)frame / (float)sample_rate;
+		frames[frame] = (Int16)(sinf(t * frequency * 6.2831853f) * expf(-t * 6.0f) * 8000.0f);
+	}
+
+	return bank.AddSample(name, &frames[0], (UInt32)frames.size(), 1, sample_rate, limits);
+}
+
+int main(int argc, char** argv)
+{
+	const int voice_count = argc > 1 ? atoi(argv[1]) : VoicePool::kMaxVoices;
+	const float seconds = argc > 2 ? (float)atof(argv[2]) : 10.0f;
+	const char* music_filename = argc > 3 ? argv[3] : NULL;
+	const char* out_filename = argc > 4 ? argv[4] : NULL;
+
+	SampleBank bank;
+	const int low = AddTone(bank, "low", 220.0f, 22050);
+	const int high = AddTone(bank, "high", 660.0f, 48000);
+
+	NullAudioSink null_sink;
+	WavFileSink file_sink;
+	AudioSink* sink = &null_sink;
+	if (out_filename && file_sink.Open(out_filename, SoftwareMixer::kOutputRate))
+		sink = &file_sink;
+
+	MusicStream music;
+	SoftwareMixer mixer;
+	mixer.Init(&bank, sink);
+	if (music_filename && music.Open(music_filename, true))
+		mixer.set_music(&music, 0.5f);
+
+	VoicePool pool;
+	pool.Init(&bank, &mixer);
+
+	const bool paced = music.is_open();
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	const int steps = (int)(seconds / kStepTime);
+	float total_mix_ms = 0.0f;
+	for (int step = 0; step < steps; ++step)
+	{
+		if (paced)
+			std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(step * kStepTime)));
+
+		// top the pool back up, panned across the field
+		for (int voice = pool.active_voices(); voice < voice_count && voice < VoicePool::kMaxVoices; ++voice)
+			pool.Play((step + voice) & 1 ? low : high, 1.0f, (float)((step * 7 + voice * 3) % 21 - 10) / 10.0f);
+
+		pool.Update(kStepTime);
+		total_mix_ms += mixer.mix_time_ms();
+	}
+
+	music.Close();
+	file_sink.Close();
+
+	const MemoryTagStats audio_memory = MemoryTracker::Stats(MEMORY_TAG_AUDIO);
+	printf("%d voices, %.1f seconds, %u frames mixed\n", voice_count, seconds, mixer.frames_mixed());
+	printf("mix %.3f ms per update, %.3f us per voice per ms of output\n", total_mix_ms / steps, mixer.voice_us_per_ms());
+	printf("bank %u bytes, music buffer %u bytes, audio peak %u bytes, %u music underruns\n",
+		(UInt32)bank.data_bytes(), (UInt32)music.buffer_bytes(), (UInt32)audio_memory.peak_bytes, music.underruns());
+
+	return 0;
+}
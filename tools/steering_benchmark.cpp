@@ -0,0 +1,177 @@
+// headless timing of enemy steering against a bare world, 50, 500 and 5000 enemies as
+// dynamic circle bodies over the 70x50 arena chasing a player that walks a circle.
+// run twice: every enemy heading straight for the player the way EnemyManager moves
+// them, and steered the way SteerEnemies does it, flow field plus separation from the
+// spatial hash. both use the easy collision layers so enemies are solved against each
+// other, the difference in contacts is the separation's. reports box2d contacts and
+// touching contacts per step, the world step time and the steering time.
+// build with SpatialHash.cpp, FlowField.cpp, JobSystem.cpp, ArenaBounds.cpp,
+// CollisionLayers.cpp, Random.cpp, game_object.cpp, box2d and gef.
+//
+// usage: steering_benchmark [steps]
+
+#include "../SpatialHash.h"
+#include "../FlowField.h"
+#include "../JobSystem.h"
+#include "../ArenaBounds.h"
+#include "../CollisionLayers.h"
+#include "../Random.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <vector>
+
+static const float kStepTime = 1.0f / 60.0f;
+static const float kHalfWidth = 35.0f;
+static const float kHalfHeight = 25.0f;
+static const float kEnemyRadius = 0.5f;
+static const float kEnemyEdgeMargin = 0.5f;
+
+// the game's steering setup, see scene_app.cpp
+static const float kSeparationRadius = 2.0f;
+static const float kSeparationStrength = 3.0f;
+static const float kFlowCellSize = 1.0f;
+static const float kEnemySpeed = 4.0f;
+static const int kSteeringGrain = 256;
+
+struct Result
+{
+	float step_ms;
+	float steer_ms;
+	int contacts;
+	int touching;
+};
+
+static float Milliseconds(std::chrono::high_resolution_clock::time_point start)
+{
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static Result Run(int enemy_count, int steps, bool steered, JobSystem* job_system)
+{
+	Random random(1);
+	CollisionLayers layers;
+	layers.Init(false);
+	ArenaBounds bounds;
+	bounds.Init(kHalfWidth, kHalfHeight);
+
+	SpatialHash grid;
+	grid.Init(kHalfWidth, kHalfHeight, kSeparationRadius);
+	FlowField flow;
+	flow.Init(kHalfWidth, kHalfHeight, kFlowCellSize);
+
+	b2World world(b2Vec2(0.0f, 0.0f));
+	std::vector<GameObject> enemy_objects(enemy_count);
+	std::vector<b2Body*> enemies(enemy_count);
+
+	b2CircleShape shape;
+	shape.m_radius = kEnemyRadius;
+
+	b2FixtureDef fixture_def;
+	fixture_def.shape = &shape;
+	fixture_def.density = 1.0f;
+	fixture_def.filter = layers.FilterFor(ENEMY);
+
+	for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+	{
+		enemy_objects[enemy_num].set_type(ENEMY);
+
+		b2BodyDef body_def;
+		body_def.type = b2_dynamicBody;
+		body_def.position.Set(random.Range(-kHalfWidth, kHalfWidth), random.Range(-kHalfHeight, kHalfHeight));
+		body_def.userData.pointer = reinterpret_cast<uintptr_t>(&enemy_objects[enemy_num]);
+
+		enemies[enemy_num] = world.CreateBody(&body_def);
+		enemies[enemy_num]->CreateFixture(&fixture_def);
+	}
+
+	std::vector<b2Vec2> positions(enemy_count);
+	std::vector<b2Vec2> steering(enemy_count);
+
+	Result result = { 0.0f, 0.0f, 0, 0 };
+
+	for (int step = 0; step < steps; ++step)
+	{
+		const float angle = step * kStepTime;
+		const b2Vec2 player(15.0f * cosf(angle), 10.0f * sinf(angle));
+
+		std::chrono::high_resolution_clock::time_point steer_start = std::chrono::high_resolution_clock::now();
+
+		for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+			positions[enemy_num] = enemies[enemy_num]->GetPosition();
+
+		if (steered)
+		{
+			flow.SetTarget(player);
+			grid.Build(&positions[0], enemy_count);
+
+			job_system->ParallelFor(enemy_count, kSteeringGrain, [&](int begin, int end)
+			{
+				grid.ComputeSeparation(kSeparationRadius, kSeparationStrength, &steering[0], begin, end);
+
+				for (int enemy_num = begin; enemy_num < end; ++enemy_num)
+					steering[enemy_num] += kEnemySpeed * flow.Sample(positions[enemy_num]);
+			});
+		}
+		else
+		{
+			for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+			{
+				b2Vec2 direction = player - positions[enemy_num];
+				direction.Normalize();
+				steering[enemy_num] = kEnemySpeed * direction;
+			}
+		}
+
+		for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+			enemies[enemy_num]->SetLinearVelocity(steering[enemy_num]);
+
+		result.steer_ms += Milliseconds(steer_start);
+
+		std::chrono::high_resolution_clock::time_point step_start = std::chrono::high_resolution_clock::now();
+		world.Step(kStepTime, 6, 2);
+		result.step_ms += Milliseconds(step_start);
+
+		// the game has no walls either, the bounds keep them in
+		for (int enemy_num = 0; enemy_num < enemy_count; ++enemy_num)
+			bounds.ClampBody(enemies[enemy_num], kEnemyEdgeMargin);
+
+		result.contacts += world.GetContactCount();
+		for (b2Contact* contact = world.GetContactList(); contact; contact = contact->GetNext())
+		{
+			if (contact->IsTouching())
+				result.touching++;
+		}
+	}
+
+	result.step_ms /= steps;
+	result.steer_ms /= steps;
+	result.contacts /= steps;
+	result.touching /= steps;
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	const int steps = argc > 1 ? atoi(argv[1]) : 600;
+
+	JobSystem job_system;
+
+	printf("%d steps, %d job threads\n", steps, job_system.thread_count());
+	printf("enemies   chasing: step ms contacts touching   steered: step ms steer ms contacts touching\n");
+
+	const int enemy_counts[] = { 50, 500, 5000 };
+	for (int count_num = 0; count_num < 3; ++count_num)
+	{
+		const int enemy_count = enemy_counts[count_num];
+		const Result chasing = Run(enemy_count, steps, false, &job_system);
+		const Result steered = Run(enemy_count, steps, true, &job_system);
+
+		printf("%7d   %16.3f %8d %8d   %16.3f %8.3f %8d %8d\n", enemy_count,
+			chasing.step_ms, chasing.contacts, chasing.touching,
+			steered.step_ms, steered.steer_ms, steered.contacts, steered.touching);
+	}
+
+	return 0;
+}
@@ -0,0 +1,227 @@
+// headless check of the voice pool's contracts under far more plays than it has voices.
+// the game's three effects with their limits, plus a low priority filler with room for
+// more copies than the pool has free, so the pool fills and has to steal. after every
+// Play it checks:
+//   no sample has more voices active than its max_voices
+//   no sample starts again within its cooldown
+//   a play into a full pool only takes a voice at or below its own priority, and is
+//   only turned away when everything playing outranks it
+// returns non-zero if any of them fails or never came up.
+// plays against the null output, which only counts.
+// build with SampleBank.cpp, WavFile.cpp, ImaAdpcm.cpp, VoicePool.cpp, MemoryTracker.cpp,
+// LinearArena.cpp and gef.
+//
+// usage: voice_pool_stress [plays per step] [steps]
+
+#include "../SampleBank.h"
+#include "../VoicePool.h"
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <vector>
+
+static const UInt32 kSampleRate = 44100;
+static const float kStepTime = 1.0f / 60.0f;
+
+struct Contract
+{
+	const char* name;
+	UInt32 checked;
+	UInt32 broken;
+};
+
+enum ContractId
+{
+	CONTRACT_MAX_VOICES,
+	CONTRACT_COOLDOWN,
+	CONTRACT_STEAL_LOWER,
+	CONTRACT_REFUSE_HIGHER,
+	NUM_CONTRACTS
+};
+
+static Contract contracts[NUM_CONTRACTS] =
+{
+	{ "active voices within max_voices", 0, 0 },
+	{ "no restart within cooldown", 0, 0 },
+	{ "full pool steals at or below priority", 0, 0 },
+	{ "full pool refuses only when outranked", 0, 0 }
+};
+
+static void Expect(ContractId id, bool held)
+{
+	contracts[id].checked++;
+	if (!held)
+		contracts[id].broken++;
+}
+
+// a decaying tone standing in for a wav, length in seconds
+static int AddTone(SampleBank& bank, const char* name, float frequency, float length, const SampleLimits& limits)
+{
+	std::vector<Int16> frames((size_t)(length * kSampleRate));
+	for (size_t frame = 0; frame < frames.size(); ++frame)
+	{
+		const float t = (float)frame / (float)kSampleRate;
+		frames[frame] = (Int16)(sinf(t * frequency * 6.2831853f) * expf(-t * 4.0f) * 20000.0f);
+	}
+
+	return bank.AddSample(name, &frames[0], (UInt32)frames.size(), 1, kSampleRate, limits);
+}
+
+static int SampleVoices(const VoicePool& pool, int sample)
+{
+	int count = 0;
+	for (int voice_num = 0; voice_num < VoicePool::kMaxVoices; ++voice_num)
+	{
+		if (pool.voice(voice_num).active && pool.voice(voice_num).sample == sample)
+			count++;
+	}
+
+	return count;
+}
+
+// plays sample and checks what the pool did against what it looked like before
+static void CheckedPlay(VoicePool& pool, const SampleBank& bank, int sample, double now, std::vector<double>& last_start)
+{
+	const SampleLimits& limits = bank.sample(sample).limits;
+
+	Voice before[VoicePool::kMaxVoices];
+	bool full = true;
+	for (int voice_num = 0; voice_num < VoicePool::kMaxVoices; ++voice_num)
+	{
+		before[voice_num] = pool.voice(voice_num);
+		if (!before[voice_num].active)
+			full = false;
+	}
+
+	const bool cooling = now - last_start[sample] < limits.cooldown;
+	const bool at_limit = SampleVoices(pool, sample) >= limits.max_voices;
+
+	const int voice_num = pool.Play(sample);
+
+	if (voice_num >= 0)
+	{
+		Expect(CONTRACT_COOLDOWN, !cooling);
+		last_start[sample] = now;
+	}
+
+	// a sample at its own limit restarts its oldest copy, that's not a steal from another
+	if (full && !cooling && !at_limit)
+	{
+		if (voice_num >= 0)
+		{
+			Expect(CONTRACT_STEAL_LOWER, before[voice_num].priority <= limits.priority);
+		}
+		else
+		{
+			bool outranked = true;
+			for (int other = 0; other < VoicePool::kMaxVoices; ++other)
+			{
+				if (before[other].priority <= limits.priority)
+					outranked = false;
+			}
+
+			Expect(CONTRACT_REFUSE_HIGHER, outranked);
+		}
+	}
+
+	for (int checked = 0; checked < bank.sample_count(); ++checked)
+		Expect(CONTRACT_MAX_VOICES, SampleVoices(pool, checked) <= bank.sample(checked).limits.max_voices);
+}
+
+// the game's effects can't fill the pool with only higher priorities, so the refusal
+// is set up on its own: a pool full of loud voices, then quiet ones asking in
+static void CheckFullOfHigher()
+{
+	const SampleLimits loud_limits = { VoicePool::kMaxVoices, 0.0f, 2 };
+	const SampleLimits quiet_limits = { VoicePool::kMaxVoices, 0.0f, 1 };
+
+	SampleBank bank;
+	const int loud = AddTone(bank, "loud", 440.0f, 1.0f, loud_limits);
+	const int quiet = AddTone(bank, "quiet", 880.0f, 1.0f, quiet_limits);
+
+	NullAudioOutput output;
+	VoicePool pool;
+	pool.Init(&bank, &output);
+
+	std::vector<double> last_start(bank.sample_count(), -1.0e9);
+	for (int play = 0; play < VoicePool::kMaxVoices; ++play)
+		CheckedPlay(pool, bank, loud, 0.0, last_start);
+
+	for (int play = 0; play < 4; ++play)
+		CheckedPlay(pool, bank, quiet, 0.0, last_start);
+}
+
+int main(int argc, char** argv)
+{
+	const int plays_per_step = argc > 1 ? atoi(argv[1]) : 40;
+	const int steps = argc > 2 ? atoi(argv[2]) : 600;
+
+	// the game's limits, see kSoundLimits in scene_app.cpp
+	const SampleLimits enemy_limits = { 4, 0.03f, 2 };
+	const SampleLimits plop_limits = { 3, 0.05f, 1 };
+	const SampleLimits hurt_limits = { 2, 0.1f, 3 };
+	const SampleLimits filler_limits = { 10, 0.0f, 0 };
+
+	SampleBank bank;
+	const int enemy = AddTone(bank, "enemy", 440.0f, 0.6f, enemy_limits);
+	const int plop = AddTone(bank, "plop", 880.0f, 0.25f, plop_limits);
+	const int hurt = AddTone(bank, "hurt", 330.0f, 0.4f, hurt_limits);
+	const int filler = AddTone(bank, "filler", 220.0f, 1.0f, filler_limits);
+
+	NullAudioOutput output;
+	VoicePool pool;
+	pool.Init(&bank, &output);
+
+	// kept the way the pool keeps its own clock so cooldowns compare exactly
+	double now = 0.0;
+	std::vector<double> last_start(bank.sample_count(), -1.0e9);
+
+	// the filler keeps the pool topped up, most contacts are plops, one in four is also
+	// a kill, and every so often the player is hurt
+	UInt32 requested = 0;
+	for (int step = 0; step < steps; ++step)
+	{
+		for (int play = 0; play < plays_per_step; ++play)
+		{
+			CheckedPlay(pool, bank, filler, now, last_start);
+			requested++;
+
+			if ((play & 3) == 0)
+			{
+				CheckedPlay(pool, bank, enemy, now, last_start);
+				requested++;
+			}
+
+			if ((play & 15) == 0 && (step % 20) == 0)
+			{
+				CheckedPlay(pool, bank, hurt, now, last_start);
+				requested++;
+			}
+
+			CheckedPlay(pool, bank, plop, now, last_start);
+			requested++;
+		}
+
+		pool.Update(kStepTime);
+		now += kStepTime;
+	}
+
+	printf("%d steps, %u plays asked for, %u started, %u stolen, %u limited\n", steps, requested, pool.plays(), pool.steals(), pool.limited());
+	printf("bank %u bytes, %d of %d voices at peak, %.2f voices mixed per step\n",
+		(UInt32)bank.data_bytes(), output.peak_voices(), VoicePool::kMaxVoices, (float)output.voices_mixed() / steps);
+
+	CheckFullOfHigher();
+
+	bool passed = true;
+	for (int id = 0; id < NUM_CONTRACTS; ++id)
+	{
+		const bool held = contracts[id].checked > 0 && contracts[id].broken == 0;
+		printf("%-40s %8u checked %6u broken  %s\n", contracts[id].name, contracts[id].checked, contracts[id].broken,
+			held ? "ok" : (contracts[id].checked == 0 ? "NOT REACHED" : "FAILED"));
+
+		if (!held)
+			passed = false;
+	}
+
+	return passed ? 0 : 1;
+}